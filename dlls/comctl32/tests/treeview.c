@@ -2623,6 +2623,56 @@ todo_wine
     DestroyWindow(hwnd);
 }
 
+static void test_WM_VSCROLL(void)
+{
+    TVINSERTSTRUCTA ins;
+    HTREEITEM items[100], item;
+    HWND hwnd;
+    BOOL ret;
+    int i;
+
+    hwnd = create_treeview_control(0);
+
+    ins.hParent = TVI_ROOT;
+    ins.hInsertAfter = TVI_LAST;
+    U(ins).item.mask = TVIF_TEXT;
+    U(ins).item.pszText = (char *)"item";
+    for (i = 0; i < 100; i++)
+    {
+        items[i] = (HTREEITEM)SendMessageA(hwnd, TVM_INSERTITEMA, 0, (LPARAM)&ins);
+        ok(items[i] != NULL, "Failed to insert item %d\n", i);
+    }
+
+    SendMessageA(hwnd, WM_VSCROLL, MAKEWPARAM(SB_THUMBPOSITION, 50), 0);
+    item = (HTREEITEM)SendMessageA(hwnd, TVM_GETNEXTITEM, TVGN_FIRSTVISIBLE, 0);
+    ok(item == items[50], "got %p, expected %p\n", item, items[50]);
+
+    SendMessageA(hwnd, WM_VSCROLL, MAKEWPARAM(SB_THUMBPOSITION, 0), 0);
+    item = (HTREEITEM)SendMessageA(hwnd, TVM_GETNEXTITEM, TVGN_FIRSTVISIBLE, 0);
+    ok(item == items[0], "got %p, expected %p\n", item, items[0]);
+
+    /* list changes while scrolled */
+    ret = SendMessageA(hwnd, TVM_DELETEITEM, 0, (LPARAM)items[10]);
+    ok(ret, "Failed to delete item\n");
+    SendMessageA(hwnd, WM_VSCROLL, MAKEWPARAM(SB_THUMBPOSITION, 50), 0);
+    item = (HTREEITEM)SendMessageA(hwnd, TVM_GETNEXTITEM, TVGN_FIRSTVISIBLE, 0);
+    ok(item == items[51], "got %p, expected %p\n", item, items[51]);
+
+    SendMessageA(hwnd, WM_SETREDRAW, FALSE, 0);
+    ins.hInsertAfter = TVI_FIRST;
+    item = (HTREEITEM)SendMessageA(hwnd, TVM_INSERTITEMA, 0, (LPARAM)&ins);
+    ok(item != NULL, "Failed to insert item\n");
+    ret = SendMessageA(hwnd, TVM_DELETEITEM, 0, (LPARAM)items[20]);
+    ok(ret, "Failed to delete item\n");
+    SendMessageA(hwnd, WM_SETREDRAW, TRUE, 0);
+
+    SendMessageA(hwnd, WM_VSCROLL, MAKEWPARAM(SB_THUMBPOSITION, 50), 0);
+    item = (HTREEITEM)SendMessageA(hwnd, TVM_GETNEXTITEM, TVGN_FIRSTVISIBLE, 0);
+    ok(item == items[51], "got %p, expected %p\n", item, items[51]);
+
+    DestroyWindow(hwnd);
+}
+
 static void test_right_click(void)
 {
     HWND hTree;
@@ -2743,6 +2793,7 @@ START_TEST(treeview)
     test_WM_KEYDOWN();
     test_TVS_FULLROWSELECT();
     test_TVM_SORTCHILDREN();
+    test_WM_VSCROLL();
     test_right_click();
 
     if (!load_v6_module(&ctx_cookie, &hCtx))
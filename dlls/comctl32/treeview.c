@@ -98,6 +98,9 @@ typedef struct tagTREEVIEW_INFO
 
   HTREEITEM     firstVisible;   /* handle to item whose top edge is at y = 0 */
   LONG          maxVisibleOrder;
+  HTREEITEM     *listItems;     /* visible items in list order, used to jump over many items */
+  LONG          listItemsSize;  /* allocated size of listItems */
+  LONG          listValidCount; /* number of entries of listItems that are up to date */
   HTREEITEM     dropItem;       /* handle to item selected by drag cursor */
   HTREEITEM     insertMarkItem; /* item after which insertion mark is placed */
   BOOL          insertBeforeorAfter; /* flag used by TVM_SETINSERTMARK */
@@ -166,6 +169,7 @@ typedef struct _TREEITEM    /* HTREEITEM is a _TREEINFO *. */
                                corresponding to a top-to-bottom ordering in the tree view.
                                Each item takes up "item.iIntegral" spots in the visible order.
                                0 is the root's first child. */
+  LONG      listIndex;      /* position in infoPtr->listItems */
   const TREEVIEW_INFO *infoPtr; /* tree data this item belongs to */
 } TREEVIEW_ITEM;
 
@@ -470,6 +474,21 @@ TREEVIEW_GetListItem(const TREEVIEW_INFO *infoPtr, TREEVIEW_ITEM *item,
 
     assert(item != NULL);
 
+    /* use the list index if it is up to date for this item */
+    if (item->listIndex < infoPtr->listValidCount && infoPtr->listItems[item->listIndex] == item)
+    {
+        LONG index = item->listIndex + count;
+
+        if (index < 0)
+            return infoPtr->listItems[0];
+        if (index < infoPtr->listValidCount)
+            return infoPtr->listItems[index];
+
+        /* walk the remaining items */
+        item = infoPtr->listItems[infoPtr->listValidCount - 1];
+        count = index - (infoPtr->listValidCount - 1);
+    }
+
     if (count > 0)
     {
 	next_item = TREEVIEW_GetNextListItem;
@@ -923,20 +942,54 @@ TREEVIEW_ComputeItemRect(const TREEVIEW_INFO *infoPtr, TREEVIEW_ITEM *item)
     item->rect.right = infoPtr->clientWidth;
 }
 
+/* Store an item at the given position of the list index. Returns FALSE if
+ * the index can't be kept up to date. */
+static BOOL
+TREEVIEW_SetListIndex(TREEVIEW_INFO *infoPtr, TREEVIEW_ITEM *item, LONG index, LONG first)
+{
+    /* the item is still listed before the updated range, the index is inconsistent */
+    if (item->listIndex < first && infoPtr->listItems[item->listIndex] == item)
+        return FALSE;
+
+    if (index >= infoPtr->listItemsSize)
+    {
+        LONG size = max(2 * infoPtr->listItemsSize, 64);
+        HTREEITEM *items = ReAlloc(infoPtr->listItems, size * sizeof(*items));
+
+        if (!items) return FALSE;
+        infoPtr->listItems = items;
+        infoPtr->listItemsSize = size;
+    }
+    infoPtr->listItems[index] = item;
+    item->listIndex = index;
+    return TRUE;
+}
+
 /* We know that only items after start need their order updated. */
 static void
 TREEVIEW_RecalculateVisibleOrder(TREEVIEW_INFO *infoPtr, TREEVIEW_ITEM *start)
 {
     TREEVIEW_ITEM *item;
     int order;
+    LONG index, first;
 
     if (!start)
     {
 	start = infoPtr->root->firstChild;
 	order = 0;
+	index = 0;
     }
     else
+    {
 	order = start->visibleOrder;
+	index = start->listIndex;
+	if (index >= infoPtr->listValidCount || infoPtr->listItems[index] != start)
+	    index = -1;
+    }
+
+    /* only the entries before start are still valid, rebuild the others as we go */
+    first = index;
+    infoPtr->listValidCount = max(index, 0);
 
     for (item = start; item != NULL;
          item = TREEVIEW_GetNextListItem(infoPtr, item))
@@ -945,9 +998,16 @@ TREEVIEW_RecalculateVisibleOrder(TREEVIEW_INFO *infoPtr, TREEVIEW_ITEM *start)
 		TREEVIEW_ComputeItemInternalMetrics(infoPtr, item);
 	item->visibleOrder = order;
 	order += item->iIntegral;
+
+	if (index >= 0 && !TREEVIEW_SetListIndex(infoPtr, item, index++, first))
+	{
+	    infoPtr->listValidCount = 0;
+	    index = -1;
+	}
     }
 
     infoPtr->maxVisibleOrder = order;
+    if (index >= 0) infoPtr->listValidCount = index;
 
     for (item = start; item != NULL;
 	 item = TREEVIEW_GetNextListItem(infoPtr, item))
@@ -1030,6 +1090,8 @@ static void
 TREEVIEW_FreeItem(TREEVIEW_INFO *infoPtr, TREEVIEW_ITEM *item)
 {
     DPA_DeletePtr(infoPtr->items, DPA_GetPtrIndex(infoPtr->items, item));
+    if (item->listIndex < infoPtr->listValidCount && infoPtr->listItems[item->listIndex] == item)
+        infoPtr->listValidCount = item->listIndex;
     if (infoPtr->selectedItem == item)
         infoPtr->selectedItem = NULL;
     if (infoPtr->hotItem == item)
@@ -1395,7 +1457,12 @@ TREEVIEW_InsertItemT(TREEVIEW_INFO *infoPtr, const TVINSERTSTRUCTW *ptdi, BOOL i
 
     TREEVIEW_VerifyTree(infoPtr);
 
-    if (!infoPtr->bRedraw) return (LRESULT)newItem;
+    if (!infoPtr->bRedraw)
+    {
+        /* the list index will be rebuilt when redrawing is enabled again */
+        infoPtr->listValidCount = 0;
+        return (LRESULT)newItem;
+    }
 
     if (parentItem == infoPtr->root ||
         (ISVISIBLE(parentItem) && parentItem->state & TVIS_EXPANDED))
@@ -5113,6 +5180,9 @@ TREEVIEW_Create(HWND hwnd, const CREATESTRUCTW *lpcs)
     infoPtr->editItem = NULL;
     infoPtr->firstVisible = NULL;
     infoPtr->maxVisibleOrder = 0;
+    infoPtr->listItems = NULL;
+    infoPtr->listItemsSize = 0;
+    infoPtr->listValidCount = 0;
     infoPtr->dropItem = NULL;
     infoPtr->insertMarkItem = NULL;
     infoPtr->insertBeforeorAfter = 0;
@@ -5187,6 +5257,7 @@ TREEVIEW_Destroy(TREEVIEW_INFO *infoPtr)
     /* root isn't freed with other items */
     TREEVIEW_FreeItem(infoPtr, infoPtr->root);
     DPA_Destroy(infoPtr->items);
+    Free(infoPtr->listItems);
 
     /* tool tip is automatically destroyed: we are its owner */
 
@@ -307,6 +307,139 @@ static int wpp_close_output(void)
     return 1;
 }
 
+/* Cache of compiled and assembled shaders. The key is the preprocessed
+ * source, so defines and the contents of any included file are taken into
+ * account, along with the target, entry point and compilation flags.
+ * Compilations with secondary data are not cached. Only results which
+ * didn't produce any messages are cached. Protected by wpp_mutex. */
+#define COMPILATION_CACHE_SIZE 64
+
+struct compilation_cache_entry
+{
+    struct list entry;
+    DWORD hash;
+    char *source;
+    char *target;
+    char *entrypoint;
+    UINT sflags;
+    UINT eflags;
+    DWORD *code;
+    DWORD code_size;
+};
+
+static struct list compilation_cache = LIST_INIT(compilation_cache);
+static unsigned int compilation_cache_count;
+
+static DWORD compilation_cache_hash(DWORD hash, const char *string)
+{
+    /* FNV-1a, the terminating NUL is included to separate the key parts. */
+    if (string)
+    {
+        while (*string)
+            hash = (hash ^ (BYTE)*string++) * 16777619;
+    }
+    return hash * 16777619;
+}
+
+static BOOL compilation_cache_strequal(const char *a, const char *b)
+{
+    return !strcmp(a ? a : "", b ? b : "");
+}
+
+static DWORD compilation_cache_get_hash(const char *source, const char *target, const char *entrypoint,
+        UINT sflags, UINT eflags)
+{
+    DWORD hash = 2166136261u;
+
+    hash = (hash ^ sflags) * 16777619;
+    hash = (hash ^ eflags) * 16777619;
+    hash = compilation_cache_hash(hash, target);
+    hash = compilation_cache_hash(hash, entrypoint);
+    return compilation_cache_hash(hash, source);
+}
+
+static BOOL compilation_cache_get(const char *source, const char *target, const char *entrypoint,
+        UINT sflags, UINT eflags, ID3DBlob **blob)
+{
+    DWORD hash = compilation_cache_get_hash(source, target, entrypoint, sflags, eflags);
+    struct compilation_cache_entry *entry;
+
+    LIST_FOR_EACH_ENTRY(entry, &compilation_cache, struct compilation_cache_entry, entry)
+    {
+        if (entry->hash != hash || entry->sflags != sflags || entry->eflags != eflags
+                || !compilation_cache_strequal(entry->target, target)
+                || !compilation_cache_strequal(entry->entrypoint, entrypoint)
+                || strcmp(entry->source, source))
+            continue;
+
+        if (FAILED(D3DCreateBlob(entry->code_size, blob)))
+            return FALSE;
+        memcpy(ID3D10Blob_GetBufferPointer(*blob), entry->code, entry->code_size);
+
+        list_remove(&entry->entry);
+        list_add_head(&compilation_cache, &entry->entry);
+        TRACE("Found cached shader, hash %#x.\n", hash);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static void compilation_cache_free_entry(struct compilation_cache_entry *entry)
+{
+    d3dcompiler_free(entry->source);
+    d3dcompiler_free(entry->target);
+    d3dcompiler_free(entry->entrypoint);
+    d3dcompiler_free(entry->code);
+    d3dcompiler_free(entry);
+}
+
+static void compilation_cache_put(const char *source, const char *target, const char *entrypoint,
+        UINT sflags, UINT eflags, const DWORD *code, DWORD code_size)
+{
+    struct compilation_cache_entry *entry;
+
+    if (!(entry = d3dcompiler_alloc(sizeof(*entry))))
+        return;
+    entry->hash = compilation_cache_get_hash(source, target, entrypoint, sflags, eflags);
+    entry->sflags = sflags;
+    entry->eflags = eflags;
+    entry->source = d3dcompiler_strdup(source);
+    entry->target = d3dcompiler_strdup(target);
+    entry->entrypoint = d3dcompiler_strdup(entrypoint);
+    entry->code = d3dcompiler_alloc(code_size);
+    entry->code_size = code_size;
+    if (!entry->source || (target && !entry->target) || (entrypoint && !entry->entrypoint) || !entry->code)
+    {
+        compilation_cache_free_entry(entry);
+        return;
+    }
+    memcpy(entry->code, code, code_size);
+
+    if (compilation_cache_count == COMPILATION_CACHE_SIZE)
+    {
+        struct compilation_cache_entry *lru = LIST_ENTRY(list_tail(&compilation_cache),
+                struct compilation_cache_entry, entry);
+
+        list_remove(&lru->entry);
+        compilation_cache_free_entry(lru);
+        --compilation_cache_count;
+    }
+    list_add_head(&compilation_cache, &entry->entry);
+    ++compilation_cache_count;
+}
+
+void compilation_cache_cleanup(void)
+{
+    struct compilation_cache_entry *entry, *next;
+
+    LIST_FOR_EACH_ENTRY_SAFE(entry, next, &compilation_cache, struct compilation_cache_entry, entry)
+    {
+        list_remove(&entry->entry);
+        compilation_cache_free_entry(entry);
+    }
+    compilation_cache_count = 0;
+}
+
 static HRESULT preprocess_shader(const void *data, SIZE_T data_size, const char *filename,
         const D3D_SHADER_MACRO *defines, ID3DInclude *include, ID3DBlob **error_messages)
 {
@@ -388,7 +521,7 @@ cleanup:
     return hr;
 }
 
-static HRESULT assemble_shader(const char *preproc_shader,
+static HRESULT assemble_shader(const char *preproc_shader, UINT flags,
         ID3DBlob **shader_blob, ID3DBlob **error_messages)
 {
     struct bwriter_shader *shader;
@@ -397,8 +530,13 @@ static HRESULT assemble_shader(const char *preproc_shader,
     DWORD *res, size;
     ID3DBlob *buffer;
     char *pos;
+    BOOL cacheable;
+
+    if (shader_blob && compilation_cache_get(preproc_shader, NULL, NULL, flags, 0, shader_blob))
+        return S_OK;
 
     shader = SlAssembleShader(preproc_shader, &messages);
+    cacheable = !messages;
 
     if (messages)
     {
@@ -460,6 +598,9 @@ static HRESULT assemble_shader(const char *preproc_shader,
         *shader_blob = buffer;
     }
 
+    if (cacheable)
+        compilation_cache_put(preproc_shader, NULL, NULL, flags, 0, res, size);
+
     HeapFree(GetProcessHeap(), 0, res);
 
     return S_OK;
@@ -485,7 +626,7 @@ HRESULT WINAPI D3DAssemble(const void *data, SIZE_T datasize, const char *filena
 
     hr = preprocess_shader(data, datasize, filename, defines, include, error_messages);
     if (SUCCEEDED(hr))
-        hr = assemble_shader(wpp_output, shader, error_messages);
+        hr = assemble_shader(wpp_output, flags, shader, error_messages);
 
     HeapFree(GetProcessHeap(), 0, wpp_output);
     LeaveCriticalSection(&wpp_mutex);
@@ -590,7 +731,7 @@ static const struct target_info * get_target_info(const char *target)
 }
 
 static HRESULT compile_shader(const char *preproc_shader, const char *target, const char *entrypoint,
-        ID3DBlob **shader_blob, ID3DBlob **error_messages)
+        UINT sflags, UINT eflags, BOOL use_cache, ID3DBlob **shader_blob, ID3DBlob **error_messages)
 {
     struct bwriter_shader *shader;
     char *messages = NULL;
@@ -600,6 +741,7 @@ static HRESULT compile_shader(const char *preproc_shader, const char *target, co
     char *pos;
     enum shader_type shader_type;
     const struct target_info *info;
+    BOOL cacheable;
 
     TRACE("Preprocessed shader source: %s\n", debugstr_a(preproc_shader));
 
@@ -625,7 +767,12 @@ static HRESULT compile_shader(const char *preproc_shader, const char *target, co
         }
     }
 
+    if (use_cache && shader_blob
+            && compilation_cache_get(preproc_shader, target, entrypoint, sflags, eflags, shader_blob))
+        return S_OK;
+
     shader = parse_hlsl_shader(preproc_shader, shader_type, major, minor, entrypoint, &messages);
+    cacheable = use_cache && !messages;
 
     if (messages)
     {
@@ -687,6 +834,9 @@ static HRESULT compile_shader(const char *preproc_shader, const char *target, co
         *shader_blob = buffer;
     }
 
+    if (cacheable)
+        compilation_cache_put(preproc_shader, target, entrypoint, sflags, eflags, res, size);
+
     HeapFree(GetProcessHeap(), 0, res);
 
     return S_OK;
@@ -717,7 +867,8 @@ HRESULT WINAPI D3DCompile2(const void *data, SIZE_T data_size, const char *filen
 
     hr = preprocess_shader(data, data_size, filename, defines, include, error_messages);
     if (SUCCEEDED(hr))
-        hr = compile_shader(wpp_output, target, entrypoint, shader, error_messages);
+        hr = compile_shader(wpp_output, target, entrypoint, sflags, eflags, !secondary_data,
+                shader, error_messages);
 
     HeapFree(GetProcessHeap(), 0, wpp_output);
     LeaveCriticalSection(&wpp_mutex);
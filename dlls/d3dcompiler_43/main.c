@@ -37,6 +37,10 @@ BOOL WINAPI DllMain(HINSTANCE inst, DWORD reason, void *reserved)
         case DLL_PROCESS_ATTACH:
             DisableThreadLibraryCalls(inst);
             break;
+        case DLL_PROCESS_DETACH:
+            if (reserved) break;
+            compilation_cache_cleanup();
+            break;
     }
     return TRUE;
 }
@@ -1532,8 +1532,17 @@ static void assembleshader_test(void) {
             NULL, NULL
         }
     };
+    static const D3D_SHADER_MACRO defines2[] =
+    {
+        {
+            "DEF2", "r1"
+        },
+        {
+            NULL, NULL
+        }
+    };
     HRESULT hr;
-    ID3DBlob *shader, *messages;
+    ID3DBlob *shader, *shader2, *messages;
     struct D3DIncludeImpl include;
 
     /* defines test */
@@ -1593,6 +1602,25 @@ static void assembleshader_test(void) {
         ID3D10Blob_Release(messages);
     }
     if(shader) ID3D10Blob_Release(shader);
+
+    /* Assembling the same source repeatedly gives the same bytecode,
+     * different defines give different bytecode. */
+    hr = D3DAssemble(test1, strlen(test1), NULL, defines, NULL, D3DCOMPILE_SKIP_VALIDATION, &shader, NULL);
+    ok(hr == S_OK, "Got unexpected hr %#x.\n", hr);
+    hr = D3DAssemble(test1, strlen(test1), NULL, defines, NULL, D3DCOMPILE_SKIP_VALIDATION, &shader2, NULL);
+    ok(hr == S_OK, "Got unexpected hr %#x.\n", hr);
+    ok(shader2 != shader, "Got the same blob.\n");
+    ok(ID3D10Blob_GetBufferSize(shader2) == ID3D10Blob_GetBufferSize(shader)
+            && !memcmp(ID3D10Blob_GetBufferPointer(shader2), ID3D10Blob_GetBufferPointer(shader),
+            ID3D10Blob_GetBufferSize(shader)), "Got different bytecode.\n");
+    ID3D10Blob_Release(shader2);
+    hr = D3DAssemble(test1, strlen(test1), NULL, defines2, NULL, D3DCOMPILE_SKIP_VALIDATION, &shader2, NULL);
+    ok(hr == S_OK, "Got unexpected hr %#x.\n", hr);
+    ok(ID3D10Blob_GetBufferSize(shader2) != ID3D10Blob_GetBufferSize(shader)
+            || memcmp(ID3D10Blob_GetBufferPointer(shader2), ID3D10Blob_GetBufferPointer(shader),
+            ID3D10Blob_GetBufferSize(shader)), "Got the same bytecode.\n");
+    ID3D10Blob_Release(shader2);
+    ID3D10Blob_Release(shader);
 }
 
 static void d3dpreprocess_test(void)
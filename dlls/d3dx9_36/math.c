@@ -1859,18 +1859,32 @@ D3DXVECTOR3* WINAPI D3DXVec3Normalize(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv)
     return pout;
 }
 
-D3DXVECTOR3* WINAPI D3DXVec3Project(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *pprojection, const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+static void vec3_transform_coord(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
 {
-    D3DXMATRIX m;
+    D3DXVECTOR3 out;
+    FLOAT norm;
 
-    TRACE("pout %p, pv %p, pviewport %p, pprojection %p, pview %p, pworld %p\n", pout, pv, pviewport, pprojection, pview, pworld);
+    norm = pm->u.m[0][3] * pv->x + pm->u.m[1][3] * pv->y + pm->u.m[2][3] *pv->z + pm->u.m[3][3];
+
+    out.x = (pm->u.m[0][0] * pv->x + pm->u.m[1][0] * pv->y + pm->u.m[2][0] * pv->z + pm->u.m[3][0]) / norm;
+    out.y = (pm->u.m[0][1] * pv->x + pm->u.m[1][1] * pv->y + pm->u.m[2][1] * pv->z + pm->u.m[3][1]) / norm;
+    out.z = (pm->u.m[0][2] * pv->x + pm->u.m[1][2] * pv->y + pm->u.m[2][2] * pv->z + pm->u.m[3][2]) / norm;
 
-    D3DXMatrixIdentity(&m);
-    if (pworld) D3DXMatrixMultiply(&m, &m, pworld);
-    if (pview) D3DXMatrixMultiply(&m, &m, pview);
-    if (pprojection) D3DXMatrixMultiply(&m, &m, pprojection);
+    *pout = out;
+}
+
+static void vec3_project_matrix(D3DXMATRIX *m, const D3DXMATRIX *pprojection,
+        const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+{
+    D3DXMatrixIdentity(m);
+    if (pworld) D3DXMatrixMultiply(m, m, pworld);
+    if (pview) D3DXMatrixMultiply(m, m, pview);
+    if (pprojection) D3DXMatrixMultiply(m, m, pprojection);
+}
 
-    D3DXVec3TransformCoord(pout, pv, &m);
+static void vec3_project(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *m)
+{
+    vec3_transform_coord(pout, pv, m);
 
     if (pviewport)
     {
@@ -1878,21 +1892,35 @@ D3DXVECTOR3* WINAPI D3DXVec3Project(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, co
         pout->y = pviewport->Y +  ( 1.0f - pout->y ) * pviewport->Height / 2.0f;
         pout->z = pviewport->MinZ + pout->z * ( pviewport->MaxZ - pviewport->MinZ );
     }
+}
+
+D3DXVECTOR3* WINAPI D3DXVec3Project(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *pprojection, const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+{
+    D3DXMATRIX m;
+
+    TRACE("pout %p, pv %p, pviewport %p, pprojection %p, pview %p, pworld %p\n", pout, pv, pviewport, pprojection, pview, pworld);
+
+    vec3_project_matrix(&m, pprojection, pview, pworld);
+    vec3_project(pout, pv, pviewport, &m);
     return pout;
 }
 
 D3DXVECTOR3* WINAPI D3DXVec3ProjectArray(D3DXVECTOR3* out, UINT outstride, const D3DXVECTOR3* in, UINT instride, const D3DVIEWPORT9* viewport, const D3DXMATRIX* projection, const D3DXMATRIX* view, const D3DXMATRIX* world, UINT elements)
 {
+    D3DXMATRIX m;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, viewport %p, projection %p, view %p, world %p, elements %u\n",
         out, outstride, in, instride, viewport, projection, view, world, elements);
 
+    /* The combined matrix is the same for every element, only build it once. */
+    vec3_project_matrix(&m, projection, view, world);
+
     for (i = 0; i < elements; ++i) {
-        D3DXVec3Project(
+        vec3_project(
             (D3DXVECTOR3*)((char*)out + outstride * i),
             (const D3DXVECTOR3*)((const char*)in + instride * i),
-            viewport, projection, view, world);
+            viewport, &m);
     }
     return out;
 }
@@ -1928,18 +1956,9 @@ D3DXVECTOR4* WINAPI D3DXVec3TransformArray(D3DXVECTOR4* out, UINT outstride, con
 
 D3DXVECTOR3* WINAPI D3DXVec3TransformCoord(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
 {
-    D3DXVECTOR3 out;
-    FLOAT norm;
-
     TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
 
-    norm = pm->u.m[0][3] * pv->x + pm->u.m[1][3] * pv->y + pm->u.m[2][3] *pv->z + pm->u.m[3][3];
-
-    out.x = (pm->u.m[0][0] * pv->x + pm->u.m[1][0] * pv->y + pm->u.m[2][0] * pv->z + pm->u.m[3][0]) / norm;
-    out.y = (pm->u.m[0][1] * pv->x + pm->u.m[1][1] * pv->y + pm->u.m[2][1] * pv->z + pm->u.m[3][1]) / norm;
-    out.z = (pm->u.m[0][2] * pv->x + pm->u.m[1][2] * pv->y + pm->u.m[2][2] * pv->z + pm->u.m[3][2]) / norm;
-
-    *pout = out;
+    vec3_transform_coord(pout, pv, pm);
 
     return pout;
 }
@@ -1951,7 +1970,7 @@ D3DXVECTOR3* WINAPI D3DXVec3TransformCoordArray(D3DXVECTOR3* out, UINT outstride
     TRACE("out %p, outstride %u, in %p, instride %u, matrix %p, elements %u\n", out, outstride, in, instride, matrix, elements);
 
     for (i = 0; i < elements; ++i) {
-        D3DXVec3TransformCoord(
+        vec3_transform_coord(
             (D3DXVECTOR3*)((char*)out + outstride * i),
             (const D3DXVECTOR3*)((const char*)in + instride * i),
             matrix);
@@ -1987,18 +2006,8 @@ D3DXVECTOR3* WINAPI D3DXVec3TransformNormalArray(D3DXVECTOR3* out, UINT outstrid
     return out;
 }
 
-D3DXVECTOR3* WINAPI D3DXVec3Unproject(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *pprojection, const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+static void vec3_unproject(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *m)
 {
-    D3DXMATRIX m;
-
-    TRACE("pout %p, pv %p, pviewport %p, pprojection %p, pview %p, pworlds %p\n", pout, pv, pviewport, pprojection, pview, pworld);
-
-    D3DXMatrixIdentity(&m);
-    if (pworld) D3DXMatrixMultiply(&m, &m, pworld);
-    if (pview) D3DXMatrixMultiply(&m, &m, pview);
-    if (pprojection) D3DXMatrixMultiply(&m, &m, pprojection);
-    D3DXMatrixInverse(&m, NULL, &m);
-
     *pout = *pv;
     if (pviewport)
     {
@@ -2006,22 +2015,39 @@ D3DXVECTOR3* WINAPI D3DXVec3Unproject(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv,
         pout->y = 1.0f - 2.0f * ( pout->y - pviewport->Y ) / pviewport->Height;
         pout->z = ( pout->z - pviewport->MinZ) / ( pviewport->MaxZ - pviewport->MinZ );
     }
-    D3DXVec3TransformCoord(pout, pout, &m);
+    vec3_transform_coord(pout, pout, m);
+}
+
+D3DXVECTOR3* WINAPI D3DXVec3Unproject(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *pprojection, const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+{
+    D3DXMATRIX m;
+
+    TRACE("pout %p, pv %p, pviewport %p, pprojection %p, pview %p, pworlds %p\n", pout, pv, pviewport, pprojection, pview, pworld);
+
+    vec3_project_matrix(&m, pprojection, pview, pworld);
+    D3DXMatrixInverse(&m, NULL, &m);
+
+    vec3_unproject(pout, pv, pviewport, &m);
     return pout;
 }
 
 D3DXVECTOR3* WINAPI D3DXVec3UnprojectArray(D3DXVECTOR3* out, UINT outstride, const D3DXVECTOR3* in, UINT instride, const D3DVIEWPORT9* viewport, const D3DXMATRIX* projection, const D3DXMATRIX* view, const D3DXMATRIX* world, UINT elements)
 {
+    D3DXMATRIX m;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, viewport %p, projection %p, view %p, world %p, elements %u\n",
         out, outstride, in, instride, viewport, projection, view, world, elements);
 
+    /* Build and invert the combined matrix once instead of per element. */
+    vec3_project_matrix(&m, projection, view, world);
+    D3DXMatrixInverse(&m, NULL, &m);
+
     for (i = 0; i < elements; ++i) {
-        D3DXVec3Unproject(
+        vec3_unproject(
             (D3DXVECTOR3*)((char*)out + outstride * i),
             (const D3DXVECTOR3*)((const char*)in + instride * i),
-            viewport, projection, view, world);
+            viewport, &m);
     }
     return out;
 }
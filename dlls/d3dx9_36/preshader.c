@@ -1647,6 +1647,44 @@ static void exec_set_arg(struct d3dx_regstore *rs, const struct d3dx_pres_reg *r
     regstore_set_double(rs, reg->table, reg->offset + comp, res);
 }
 
+static BOOL exec_is_direct_arg(struct d3dx_regstore *rs, const struct d3dx_pres_operand *opr,
+        unsigned int component_count)
+{
+    return opr->index_reg.table == PRES_REGTAB_COUNT
+            && get_reg_offset(opr->reg.table, opr->reg.offset + component_count - 1)
+            < rs->table_sizes[opr->reg.table];
+}
+
+/* Fast path for the most frequent arithmetic instructions with non relative
+ * addressed, in bounds operands. Avoids the per component operand address
+ * resolution and the indirect op function call. */
+static BOOL exec_simple_ins(struct d3dx_regstore *rs, const struct d3dx_pres_ins *ins)
+{
+    const struct d3dx_pres_operand *in0 = &ins->inputs[0], *in1 = &ins->inputs[1];
+    const struct d3dx_pres_reg *out = &ins->output.reg;
+    unsigned int j, comp0;
+    double res;
+
+    if (ins->op != PRESHADER_OP_MOV && ins->op != PRESHADER_OP_ADD && ins->op != PRESHADER_OP_MUL)
+        return FALSE;
+    if (!exec_is_direct_arg(rs, in0, ins->scalar_op ? 1 : ins->component_count))
+        return FALSE;
+    if (ins->op != PRESHADER_OP_MOV && !exec_is_direct_arg(rs, in1, ins->component_count))
+        return FALSE;
+
+    for (j = 0; j < ins->component_count; ++j)
+    {
+        comp0 = ins->scalar_op ? 0 : j;
+        res = regstore_get_double(rs, in0->reg.table, in0->reg.offset + comp0);
+        if (ins->op == PRESHADER_OP_ADD)
+            res += regstore_get_double(rs, in1->reg.table, in1->reg.offset + j);
+        else if (ins->op == PRESHADER_OP_MUL)
+            res *= regstore_get_double(rs, in1->reg.table, in1->reg.offset + j);
+        regstore_set_double(rs, out->table, out->offset + j, res);
+    }
+    return TRUE;
+}
+
 #define ARGS_ARRAY_SIZE 8
 static HRESULT execute_preshader(struct d3dx_preshader *pres)
 {
@@ -1677,7 +1715,7 @@ static HRESULT execute_preshader(struct d3dx_preshader *pres)
             /* only 'dot' instruction currently falls here */
             exec_set_arg(&pres->regs, &ins->output.reg, 0, res);
         }
-        else
+        else if (!exec_simple_ins(&pres->regs, ins))
         {
             for (j = 0; j < ins->component_count; ++j)
             {
@@ -1622,6 +1622,118 @@ void copy_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slice_pitch,
     }
 }
 
+/* Specialized row converters for the most common format pairs. They produce
+ * the same results as the generic get_relevant_argb_components() /
+ * make_argb_color() path, without per-pixel channel setup. */
+typedef void (*convert_row_func)(const BYTE *src, BYTE *dst, unsigned int width);
+
+static void convert_row_8888_x888(const BYTE *src, BYTE *dst, unsigned int width)
+{
+    const DWORD *src_ptr = (const DWORD *)src;
+    DWORD *dst_ptr = (DWORD *)dst;
+    unsigned int x;
+
+    for (x = 0; x < width; ++x)
+        dst_ptr[x] = src_ptr[x] & 0x00ffffff;
+}
+
+static void convert_row_x888_8888(const BYTE *src, BYTE *dst, unsigned int width)
+{
+    const DWORD *src_ptr = (const DWORD *)src;
+    DWORD *dst_ptr = (DWORD *)dst;
+    unsigned int x;
+
+    for (x = 0; x < width; ++x)
+        dst_ptr[x] = src_ptr[x] | 0xff000000;
+}
+
+static void convert_row_swap_rb_32(const BYTE *src, BYTE *dst, unsigned int width)
+{
+    const DWORD *src_ptr = (const DWORD *)src;
+    DWORD *dst_ptr = (DWORD *)dst;
+    unsigned int x;
+    DWORD val;
+
+    for (x = 0; x < width; ++x)
+    {
+        val = src_ptr[x];
+        dst_ptr[x] = (val & 0xff00ff00) | ((val >> 16) & 0xff) | ((val & 0xff) << 16);
+    }
+}
+
+static inline DWORD r5g6b5_to_x888(WORD val)
+{
+    DWORD r = (val >> 11) & 0x1f, g = (val >> 5) & 0x3f, b = val & 0x1f;
+
+    return ((r << 3 | r >> 2) << 16) | ((g << 2 | g >> 4) << 8) | (b << 3 | b >> 2);
+}
+
+static void convert_row_565_8888(const BYTE *src, BYTE *dst, unsigned int width)
+{
+    const WORD *src_ptr = (const WORD *)src;
+    DWORD *dst_ptr = (DWORD *)dst;
+    unsigned int x;
+
+    for (x = 0; x < width; ++x)
+        dst_ptr[x] = r5g6b5_to_x888(src_ptr[x]) | 0xff000000;
+}
+
+static void convert_row_565_x888(const BYTE *src, BYTE *dst, unsigned int width)
+{
+    const WORD *src_ptr = (const WORD *)src;
+    DWORD *dst_ptr = (DWORD *)dst;
+    unsigned int x;
+
+    for (x = 0; x < width; ++x)
+        dst_ptr[x] = r5g6b5_to_x888(src_ptr[x]);
+}
+
+static void convert_row_8888_565(const BYTE *src, BYTE *dst, unsigned int width)
+{
+    const DWORD *src_ptr = (const DWORD *)src;
+    WORD *dst_ptr = (WORD *)dst;
+    unsigned int x;
+    DWORD val;
+
+    for (x = 0; x < width; ++x)
+    {
+        val = src_ptr[x];
+        dst_ptr[x] = ((val >> 8) & 0xf800) | ((val >> 5) & 0x07e0) | ((val >> 3) & 0x001f);
+    }
+}
+
+static const struct
+{
+    D3DFORMAT src_format;
+    D3DFORMAT dst_format;
+    convert_row_func convert_row;
+}
+convert_row_funcs[] =
+{
+    {D3DFMT_A8R8G8B8, D3DFMT_X8R8G8B8, convert_row_8888_x888},
+    {D3DFMT_A8B8G8R8, D3DFMT_X8B8G8R8, convert_row_8888_x888},
+    {D3DFMT_X8R8G8B8, D3DFMT_A8R8G8B8, convert_row_x888_8888},
+    {D3DFMT_X8B8G8R8, D3DFMT_A8B8G8R8, convert_row_x888_8888},
+    {D3DFMT_A8R8G8B8, D3DFMT_A8B8G8R8, convert_row_swap_rb_32},
+    {D3DFMT_A8B8G8R8, D3DFMT_A8R8G8B8, convert_row_swap_rb_32},
+    {D3DFMT_R5G6B5,   D3DFMT_A8R8G8B8, convert_row_565_8888},
+    {D3DFMT_R5G6B5,   D3DFMT_X8R8G8B8, convert_row_565_x888},
+    {D3DFMT_A8R8G8B8, D3DFMT_R5G6B5,   convert_row_8888_565},
+    {D3DFMT_X8R8G8B8, D3DFMT_R5G6B5,   convert_row_8888_565},
+};
+
+static convert_row_func get_convert_row_func(D3DFORMAT src_format, D3DFORMAT dst_format)
+{
+    unsigned int i;
+
+    for (i = 0; i < ARRAY_SIZE(convert_row_funcs); ++i)
+    {
+        if (convert_row_funcs[i].src_format == src_format && convert_row_funcs[i].dst_format == dst_format)
+            return convert_row_funcs[i].convert_row;
+    }
+    return NULL;
+}
+
 /************************************************************
  * convert_argb_pixels
  *
@@ -1636,6 +1748,7 @@ void convert_argb_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slice_pit
 {
     struct argb_conversion_info conv_info, ck_conv_info;
     const struct pixel_format_desc *ck_format = NULL;
+    convert_row_func convert_row = NULL;
     DWORD channels[4];
     UINT min_width, min_height, min_depth;
     UINT x, y, z;
@@ -1653,6 +1766,10 @@ void convert_argb_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slice_pit
         ck_format = get_format_info(D3DFMT_A8R8G8B8);
         init_argb_conversion_info(src_format, ck_format, &ck_conv_info);
     }
+    else
+    {
+        convert_row = get_convert_row_func(src_format->format, dst_format->format);
+    }
 
     for (z = 0; z < min_depth; z++) {
         const BYTE *src_slice_ptr = src + z * src_slice_pitch;
@@ -1662,6 +1779,15 @@ void convert_argb_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slice_pit
             const BYTE *src_ptr = src_slice_ptr + y * src_row_pitch;
             BYTE *dst_ptr = dst_slice_ptr + y * dst_row_pitch;
 
+            if (convert_row)
+            {
+                convert_row(src_ptr, dst_ptr, min_width);
+                if (src_size->width < dst_size->width) /* black out remaining pixels */
+                    memset(dst_ptr + min_width * dst_format->bytes_per_pixel, 0,
+                            dst_format->bytes_per_pixel * (dst_size->width - src_size->width));
+                continue;
+            }
+
             for (x = 0; x < min_width; x++) {
                 if (!src_format->to_rgba && !dst_format->from_rgba
                         && src_format->type == dst_format->type
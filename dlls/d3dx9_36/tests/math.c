@@ -2303,6 +2303,7 @@ static void test_D3DXVec_Array(void)
     D3DXVECTOR4 inp_vec[5], out_vec[7], exp_vec[7];
     D3DXMATRIX mat, projection, view, world;
     D3DVIEWPORT9 viewport;
+    D3DXVECTOR3 vec3;
     unsigned int i;
 
     viewport.Width = 800; viewport.MinZ = 0.2f; viewport.X = 10;
@@ -2387,6 +2388,11 @@ static void test_D3DXVec_Array(void)
     D3DXVec3ProjectArray((D3DXVECTOR3 *)&out_vec[1], sizeof(*out_vec), (D3DXVECTOR3 *)inp_vec,
             sizeof(*inp_vec), &viewport, &projection, &view, &world, ARRAY_SIZE(inp_vec));
     expect_vec4_array(ARRAY_SIZE(exp_vec), exp_vec, out_vec, 8);
+    for (i = 0; i < ARRAY_SIZE(inp_vec); ++i)
+    {
+        D3DXVec3Project(&vec3, (D3DXVECTOR3 *)&inp_vec[i], &viewport, &projection, &view, &world);
+        ok(compare_vec3(&vec3, (D3DXVECTOR3 *)&out_vec[i + 1], 8), "Got unexpected vector %u.\n", i);
+    }
 
     /* D3DXVec3UnprojectArray */
     exp_vec[1].x = -6.12403107e+00f; exp_vec[1].y = 3.22536016e+00f; exp_vec[1].z = 6.20571136e-01f;
@@ -2397,6 +2403,11 @@ static void test_D3DXVec_Array(void)
     D3DXVec3UnprojectArray((D3DXVECTOR3 *)&out_vec[1], sizeof(*out_vec), (D3DXVECTOR3 *)inp_vec,
             sizeof(*inp_vec), &viewport, &projection, &view, &world, ARRAY_SIZE(inp_vec));
     expect_vec4_array(ARRAY_SIZE(exp_vec), exp_vec, out_vec, 4);
+    for (i = 0; i < ARRAY_SIZE(inp_vec); ++i)
+    {
+        D3DXVec3Unproject(&vec3, (D3DXVECTOR3 *)&inp_vec[i], &viewport, &projection, &view, &world);
+        ok(compare_vec3(&vec3, (D3DXVECTOR3 *)&out_vec[i + 1], 4), "Got unexpected vector %u.\n", i);
+    }
 
     /* D3DXVec2TransformArray */
     exp_vec[1].x = 38.0f; exp_vec[1].y = 44.0f; exp_vec[1].z = 50.0f; exp_vec[1].w = 56.0f;
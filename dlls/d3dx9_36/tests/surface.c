@@ -1256,6 +1256,84 @@ static void test_D3DXLoadSurface(IDirect3DDevice9 *device)
     if(testbitmap_ok) DeleteFileA("testbitmap.bmp");
 }
 
+static void test_D3DXLoadSurface_conversions(IDirect3DDevice9 *device)
+{
+    static const DWORD pixdata_8888[] = { 0xff84ff42, 0x00ff8284, 0x12000000, 0x7f428241 };
+    static const WORD pixdata_r5g6b5[] = { 0x9ef6, 0x658d, 0x0aee, 0x42ee };
+    static const struct
+    {
+        D3DFORMAT src_format;
+        const void *src_data;
+        UINT src_pitch;
+        D3DFORMAT dst_format;
+        DWORD mask;
+        DWORD expected[4];
+    }
+    tests[] =
+    {
+        {D3DFMT_A8R8G8B8, pixdata_8888, 8, D3DFMT_X8R8G8B8, 0x00ffffff,
+                {0x0084ff42, 0x00ff8284, 0x00000000, 0x00428241}},
+        {D3DFMT_A8B8G8R8, pixdata_8888, 8, D3DFMT_X8B8G8R8, 0x00ffffff,
+                {0x0084ff42, 0x00ff8284, 0x00000000, 0x00428241}},
+        /* the alpha channel is filled for X8 sources */
+        {D3DFMT_X8R8G8B8, pixdata_8888, 8, D3DFMT_A8R8G8B8, 0xffffffff,
+                {0xff84ff42, 0xffff8284, 0xff000000, 0xff428241}},
+        {D3DFMT_X8B8G8R8, pixdata_8888, 8, D3DFMT_A8B8G8R8, 0xffffffff,
+                {0xff84ff42, 0xffff8284, 0xff000000, 0xff428241}},
+        {D3DFMT_A8R8G8B8, pixdata_8888, 8, D3DFMT_A8B8G8R8, 0xffffffff,
+                {0xff42ff84, 0x008482ff, 0x12000000, 0x7f418242}},
+        {D3DFMT_A8B8G8R8, pixdata_8888, 8, D3DFMT_A8R8G8B8, 0xffffffff,
+                {0xff42ff84, 0x008482ff, 0x12000000, 0x7f418242}},
+        {D3DFMT_R5G6B5, pixdata_r5g6b5, 4, D3DFMT_A8R8G8B8, 0xffffffff,
+                {0xff9cdfb5, 0xff63b26b, 0xff085d73, 0xff425d73}},
+        {D3DFMT_R5G6B5, pixdata_r5g6b5, 4, D3DFMT_X8R8G8B8, 0x00ffffff,
+                {0x009cdfb5, 0x0063b26b, 0x00085d73, 0x00425d73}},
+        {D3DFMT_A8R8G8B8, pixdata_8888, 8, D3DFMT_R5G6B5, 0xffff,
+                {0x87e8, 0xfc10, 0x0000, 0x4408}},
+        {D3DFMT_X8R8G8B8, pixdata_8888, 8, D3DFMT_R5G6B5, 0xffff,
+                {0x87e8, 0xfc10, 0x0000, 0x4408}},
+    };
+    static const RECT rect = {0, 0, 2, 2};
+    IDirect3DSurface9 *surf;
+    D3DLOCKED_RECT lockrect;
+    unsigned int i, j;
+    DWORD color;
+    HRESULT hr;
+
+    for (i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i)
+    {
+        hr = IDirect3DDevice9_CreateOffscreenPlainSurface(device, 2, 2, tests[i].dst_format,
+                D3DPOOL_DEFAULT, &surf, NULL);
+        if (FAILED(hr))
+        {
+            skip("Failed to create a surface of format %#x, hr %#x.\n", tests[i].dst_format, hr);
+            continue;
+        }
+
+        hr = D3DXLoadSurfaceFromMemory(surf, NULL, NULL, tests[i].src_data, tests[i].src_format,
+                tests[i].src_pitch, NULL, &rect, D3DX_FILTER_NONE, 0);
+        ok(hr == D3D_OK, "Test %u: Got unexpected hr %#x.\n", i, hr);
+        hr = IDirect3DSurface9_LockRect(surf, &lockrect, NULL, D3DLOCK_READONLY);
+        ok(SUCCEEDED(hr), "Test %u: Failed to lock surface, hr %#x.\n", i, hr);
+        for (j = 0; j < 4; ++j)
+        {
+            const BYTE *row = (const BYTE *)lockrect.pBits + (j / 2) * lockrect.Pitch;
+
+            if (tests[i].dst_format == D3DFMT_R5G6B5)
+                color = ((const WORD *)row)[j % 2];
+            else
+                color = ((const DWORD *)row)[j % 2];
+            ok((color & tests[i].mask) == tests[i].expected[j],
+                    "Test %u: Got unexpected color 0x%08x for pixel %u, expected 0x%08x.\n",
+                    i, color & tests[i].mask, j, tests[i].expected[j]);
+        }
+        hr = IDirect3DSurface9_UnlockRect(surf);
+        ok(SUCCEEDED(hr), "Test %u: Failed to unlock surface, hr %#x.\n", i, hr);
+
+        check_release((IUnknown *)surf, 0);
+    }
+}
+
 static void test_D3DXSaveSurfaceToFileInMemory(IDirect3DDevice9 *device)
 {
     HRESULT hr;
@@ -1461,6 +1539,7 @@ START_TEST(surface)
 
     test_D3DXGetImageInfo();
     test_D3DXLoadSurface(device);
+    test_D3DXLoadSurface_conversions(device);
     test_D3DXSaveSurfaceToFileInMemory(device);
     test_D3DXSaveSurfaceToFile(device);
 
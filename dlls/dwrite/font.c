@@ -206,6 +206,8 @@ struct dwrite_colorglyphenum {
 #define GLYPH_BLOCK_MASK  (GLYPH_BLOCK_SIZE - 1)
 #define GLYPH_MAX         65536
 
+#define GLYPH_BITMAP_CACHE_MAX_SIZE (256 * 1024)
+
 enum fontface_flags {
     FONTFACE_IS_SYMBOL             = 1 << 0,
     FONTFACE_IS_MONOSPACED         = 1 << 1,
@@ -247,6 +249,13 @@ struct dwrite_fontface {
     UINT32 glyph_image_formats;
 
     LOGFONTW lf;
+
+    /* rendered glyph bitmaps, most recently used first */
+    struct list bitmap_sizes;
+    struct list bitmap_lru;
+    UINT32 bitmap_cache_size;
+    UINT32 bitmap_hits;
+    UINT32 bitmap_misses;
 };
 
 struct dwrite_fontfile {
@@ -344,6 +353,75 @@ static HRESULT set_cached_glyph_metrics(struct dwrite_fontface *fontface, UINT16
     return S_OK;
 }
 
+/* Glyphs rendered with the same size, transform and rendering mode. */
+struct glyph_bitmap_size {
+    struct list entry;
+    FLOAT emsize;
+    BOOL has_transform;
+    DWRITE_MATRIX m;
+    DWRITE_RENDERING_MODE1 rendering_mode;
+    UINT32 count;
+    struct glyph_bitmap **glyphs[GLYPH_MAX/GLYPH_BLOCK_SIZE];
+};
+
+struct glyph_bitmap {
+    struct list entry;
+    struct glyph_bitmap_size *size;
+    UINT16 index;
+    BOOL is_1bpp;
+    INT pitch;
+    RECT bbox;
+    BYTE bits[1];
+};
+
+static CRITICAL_SECTION glyph_bitmap_cs;
+static CRITICAL_SECTION_DEBUG glyph_bitmap_cs_debug =
+{
+    0, 0, &glyph_bitmap_cs,
+    { &glyph_bitmap_cs_debug.ProcessLocksList, &glyph_bitmap_cs_debug.ProcessLocksList },
+      0, 0, { (DWORD_PTR)(__FILE__ ": glyph_bitmap_cs") }
+};
+static CRITICAL_SECTION glyph_bitmap_cs = { &glyph_bitmap_cs_debug, -1, 0, 0, 0, 0 };
+
+static inline UINT32 get_glyph_bitmap_data_size(const struct glyph_bitmap *glyph)
+{
+    return glyph->pitch * (glyph->bbox.bottom - glyph->bbox.top);
+}
+
+static void release_glyph_bitmap_size(struct glyph_bitmap_size *size)
+{
+    UINT32 i;
+
+    list_remove(&size->entry);
+    for (i = 0; i < sizeof(size->glyphs)/sizeof(size->glyphs[0]); i++)
+        heap_free(size->glyphs[i]);
+    heap_free(size);
+}
+
+static void release_glyph_bitmap(struct dwrite_fontface *fontface, struct glyph_bitmap *glyph)
+{
+    struct glyph_bitmap_size *size = glyph->size;
+
+    size->glyphs[glyph->index >> GLYPH_BLOCK_SHIFT][glyph->index & GLYPH_BLOCK_MASK] = NULL;
+    if (!--size->count)
+        release_glyph_bitmap_size(size);
+
+    fontface->bitmap_cache_size -= get_glyph_bitmap_data_size(glyph);
+    list_remove(&glyph->entry);
+    heap_free(glyph);
+}
+
+static void release_glyph_bitmap_cache(struct dwrite_fontface *fontface)
+{
+    struct glyph_bitmap *glyph, *glyph2;
+
+    TRACE("%p: glyph bitmap cache %u hits, %u misses, %u bytes\n", fontface, fontface->bitmap_hits,
+            fontface->bitmap_misses, fontface->bitmap_cache_size);
+
+    LIST_FOR_EACH_ENTRY_SAFE(glyph, glyph2, &fontface->bitmap_lru, struct glyph_bitmap, entry)
+        release_glyph_bitmap(fontface, glyph);
+}
+
 static void* get_fontface_table(IDWriteFontFace4 *fontface, UINT32 tag, struct dwrite_fonttable *table)
 {
     HRESULT hr;
@@ -426,7 +504,8 @@ static void release_font_data(struct dwrite_font_data *data)
     if (data->names)
         IDWriteLocalizedStrings_Release(data->names);
 
-    IDWriteFontFile_Release(data->file);
+    if (data->file)
+        IDWriteFontFile_Release(data->file);
     heap_free(data->facename);
     heap_free(data);
 }
@@ -524,6 +603,7 @@ static ULONG WINAPI dwritefontface_Release(IDWriteFontFace4 *iface)
 
         for (i = 0; i < sizeof(This->glyphs)/sizeof(This->glyphs[0]); i++)
             heap_free(This->glyphs[i]);
+        release_glyph_bitmap_cache(This);
 
         freetype_notify_cacheremove(iface);
 
@@ -3665,6 +3745,195 @@ static void fontcollection_add_replacements(struct dwrite_fontcollection *collec
     RegCloseKey(hkey);
 }
 
+/* Faces found in local font files, shared by collections of all factories. Local file
+   reference keys include last write time, so modified files are scanned again. */
+struct font_index_face {
+    struct dwrite_font_data *data;
+    IDWriteLocalizedStrings *family_name;
+};
+
+struct font_index_entry {
+    struct list entry;
+    void *key;
+    UINT32 key_size;
+    DWRITE_FONT_FACE_TYPE face_type;
+    UINT32 face_count;
+    struct font_index_face faces[1];
+};
+
+static struct list font_index = LIST_INIT(font_index);
+
+static CRITICAL_SECTION font_index_cs;
+static CRITICAL_SECTION_DEBUG font_index_cs_debug =
+{
+    0, 0, &font_index_cs,
+    { &font_index_cs_debug.ProcessLocksList, &font_index_cs_debug.ProcessLocksList },
+      0, 0, { (DWORD_PTR)(__FILE__ ": font_index_cs") }
+};
+static CRITICAL_SECTION font_index_cs = { &font_index_cs_debug, -1, 0, 0, 0, 0 };
+
+static HRESULT init_font_data_from_data(const struct dwrite_font_data *src, IDWriteFontFile *file,
+        struct dwrite_font_data **ret)
+{
+    struct dwrite_font_data *data;
+    HRESULT hr;
+
+    *ret = NULL;
+
+    data = heap_alloc(sizeof(*data));
+    if (!data)
+        return E_OUTOFMEMORY;
+
+    *data = *src;
+    data->ref = 1;
+    data->file = file;
+    data->bold_sim_tested = 0;
+    data->oblique_sim_tested = 0;
+    memset(data->info_strings, 0, sizeof(data->info_strings));
+    if (FAILED(hr = clone_localizedstring(src->names, &data->names))) {
+        heap_free(data);
+        return hr;
+    }
+    if (data->file)
+        IDWriteFontFile_AddRef(data->file);
+
+    *ret = data;
+    return S_OK;
+}
+
+static BOOL is_local_fontfile(IDWriteFontFile *file)
+{
+    IDWriteFontFileLoader *loader;
+    BOOL ret;
+
+    if (FAILED(IDWriteFontFile_GetLoader(file, &loader)))
+        return FALSE;
+
+    ret = loader == get_local_fontfile_loader();
+    IDWriteFontFileLoader_Release(loader);
+    return ret;
+}
+
+static void release_font_index_entry(struct font_index_entry *entry)
+{
+    UINT32 i;
+
+    for (i = 0; i < entry->face_count; i++) {
+        if (!entry->faces[i].data)
+            continue;
+        release_font_data(entry->faces[i].data);
+        IDWriteLocalizedStrings_Release(entry->faces[i].family_name);
+    }
+    heap_free(entry->key);
+    heap_free(entry);
+}
+
+static struct font_index_entry *alloc_font_index_entry(IDWriteFontFile *file, DWRITE_FONT_FACE_TYPE face_type,
+        UINT32 face_count)
+{
+    struct font_index_entry *entry;
+    const void *key;
+    UINT32 key_size;
+
+    if (!is_local_fontfile(file) || FAILED(IDWriteFontFile_GetReferenceKey(file, &key, &key_size)))
+        return NULL;
+
+    entry = heap_alloc_zero(FIELD_OFFSET(struct font_index_entry, faces[face_count]));
+    if (!entry)
+        return NULL;
+
+    if (!(entry->key = heap_alloc(key_size))) {
+        heap_free(entry);
+        return NULL;
+    }
+    memcpy(entry->key, key, key_size);
+    entry->key_size = key_size;
+    entry->face_type = face_type;
+    entry->face_count = face_count;
+
+    return entry;
+}
+
+static void font_index_set_face(struct font_index_entry *entry, UINT32 index, const struct dwrite_font_data *data,
+        IDWriteLocalizedStrings *family_name)
+{
+    struct font_index_face *face = &entry->faces[index];
+
+    if (FAILED(init_font_data_from_data(data, NULL, &face->data)))
+        return;
+
+    if (FAILED(clone_localizedstring(family_name, &face->family_name))) {
+        release_font_data(face->data);
+        face->data = NULL;
+    }
+}
+
+/* Once added, entries are not modified until the module is unloaded. */
+static void font_index_add_entry(struct font_index_entry *entry)
+{
+    struct font_index_entry *cur;
+
+    EnterCriticalSection(&font_index_cs);
+    LIST_FOR_EACH_ENTRY(cur, &font_index, struct font_index_entry, entry) {
+        if (cur->key_size == entry->key_size && !memcmp(cur->key, entry->key, entry->key_size)) {
+            LeaveCriticalSection(&font_index_cs);
+            release_font_index_entry(entry);
+            return;
+        }
+    }
+    list_add_head(&font_index, &entry->entry);
+    LeaveCriticalSection(&font_index_cs);
+}
+
+static const struct font_index_entry *font_index_find_entry(IDWriteFontFile *file)
+{
+    struct font_index_entry *cur, *ret = NULL;
+    const void *key;
+    UINT32 key_size;
+
+    if (!is_local_fontfile(file) || FAILED(IDWriteFontFile_GetReferenceKey(file, &key, &key_size)))
+        return NULL;
+
+    EnterCriticalSection(&font_index_cs);
+    LIST_FOR_EACH_ENTRY(cur, &font_index, struct font_index_entry, entry) {
+        if (cur->key_size == key_size && !memcmp(cur->key, key, key_size)) {
+            ret = cur;
+            break;
+        }
+    }
+    LeaveCriticalSection(&font_index_cs);
+
+    return ret;
+}
+
+static HRESULT init_font_data_from_index(const struct font_index_face *face, IDWriteFontFile *file,
+        IDWriteLocalizedStrings **family_name, struct dwrite_font_data **ret)
+{
+    HRESULT hr;
+
+    *family_name = NULL;
+
+    if (FAILED(hr = init_font_data_from_data(face->data, file, ret)))
+        return hr;
+
+    if (FAILED(hr = clone_localizedstring(face->family_name, family_name))) {
+        release_font_data(*ret);
+        *ret = NULL;
+    }
+
+    return hr;
+}
+
+void release_font_index(void)
+{
+    struct font_index_entry *cur, *cur2;
+
+    LIST_FOR_EACH_ENTRY_SAFE(cur, cur2, &font_index, struct font_index_entry, entry) {
+        list_remove(&cur->entry);
+        release_font_index_entry(cur);
+    }
+}
+
 HRESULT create_font_collection(IDWriteFactory5 *factory, IDWriteFontFileEnumerator *enumerator, BOOL is_system,
     IDWriteFontCollection1 **ret)
 {
@@ -3696,6 +3965,8 @@ HRESULT create_font_collection(IDWriteFactory5 *factory, IDWriteFontFileEnumerat
 
     list_init(&scannedfiles);
     while (hr == S_OK) {
+        const struct font_index_entry *indexed;
+        struct font_index_entry *index_entry;
         DWRITE_FONT_FACE_TYPE face_type;
         DWRITE_FONT_FILE_TYPE file_type;
         BOOL supported, same = FALSE;
@@ -3723,19 +3994,36 @@ HRESULT create_font_collection(IDWriteFactory5 *factory, IDWriteFontFileEnumerat
             continue;
         }
 
-        if (FAILED(get_filestream_from_file(file, &stream))) {
-            IDWriteFontFile_Release(file);
-            continue;
+        /* Files scanned before don't have to be opened again. */
+        stream = NULL;
+        index_entry = NULL;
+        if ((indexed = font_index_find_entry(file))) {
+            face_type = indexed->face_type;
+            face_count = indexed->face_count;
+            if (face_count == 0) {
+                IDWriteFontFile_Release(file);
+                continue;
+            }
         }
+        else {
+            if (FAILED(get_filestream_from_file(file, &stream))) {
+                IDWriteFontFile_Release(file);
+                continue;
+            }
 
-        /* Unsupported formats are skipped. */
-        hr = opentype_analyze_font(stream, &supported, &file_type, &face_type, &face_count);
-        if (FAILED(hr) || !supported || face_count == 0) {
-            TRACE("Unsupported font (%p, 0x%08x, %d, %u)\n", file, hr, supported, face_count);
-            IDWriteFontFileStream_Release(stream);
-            IDWriteFontFile_Release(file);
-            hr = S_OK;
-            continue;
+            /* Unsupported formats are skipped. */
+            hr = opentype_analyze_font(stream, &supported, &file_type, &face_type, &face_count);
+            if (FAILED(hr) || !supported || face_count == 0) {
+                TRACE("Unsupported font (%p, 0x%08x, %d, %u)\n", file, hr, supported, face_count);
+                if (SUCCEEDED(hr) && (index_entry = alloc_font_index_entry(file, face_type, 0)))
+                    font_index_add_entry(index_entry);
+                IDWriteFontFileStream_Release(stream);
+                IDWriteFontFile_Release(file);
+                hr = S_OK;
+                continue;
+            }
+
+            index_entry = alloc_font_index_entry(file, face_type, face_count);
         }
 
         /* add to scanned list */
@@ -3750,17 +4038,26 @@ HRESULT create_font_collection(IDWriteFactory5 *factory, IDWriteFontFileEnumerat
             WCHAR familyW[255];
             UINT32 index;
 
-            desc.factory = factory;
-            desc.face_type = face_type;
-            desc.files = &file;
-            desc.stream = stream;
-            desc.files_number = 1;
-            desc.index = i;
-            desc.simulations = DWRITE_FONT_SIMULATIONS_NONE;
-            desc.font_data = NULL;
-
-            /* alloc and init new font data structure */
-            hr = init_font_data(&desc, &family_name, &font_data);
+            if (indexed) {
+                if (!indexed->faces[i].data)
+                    continue;
+                hr = init_font_data_from_index(&indexed->faces[i], file, &family_name, &font_data);
+            }
+            else {
+                desc.factory = factory;
+                desc.face_type = face_type;
+                desc.files = &file;
+                desc.stream = stream;
+                desc.files_number = 1;
+                desc.index = i;
+                desc.simulations = DWRITE_FONT_SIMULATIONS_NONE;
+                desc.font_data = NULL;
+
+                /* alloc and init new font data structure */
+                hr = init_font_data(&desc, &family_name, &font_data);
+                if (SUCCEEDED(hr) && index_entry)
+                    font_index_set_face(index_entry, i, font_data, family_name);
+            }
             if (FAILED(hr)) {
                 /* move to next one */
                 hr = S_OK;
@@ -3801,6 +4098,15 @@ HRESULT create_font_collection(IDWriteFactory5 *factory, IDWriteFontFileEnumerat
             if (FAILED(hr))
                 break;
         }
+
+        if (index_entry) {
+            if (SUCCEEDED(hr))
+                font_index_add_entry(index_entry);
+            else
+                release_font_index_entry(index_entry);
+        }
+        if (stream)
+            IDWriteFontFileStream_Release(stream);
     }
 
     LIST_FOR_EACH_ENTRY_SAFE(fileenum, fileenum2, &scannedfiles, struct fontfile_enum, entry) {
@@ -4337,6 +4643,8 @@ HRESULT create_fontface(const struct fontface_desc *desc, struct list *cached_li
     fontface = heap_alloc_zero(sizeof(struct dwrite_fontface));
     if (!fontface)
         return E_OUTOFMEMORY;
+    list_init(&fontface->bitmap_sizes);
+    list_init(&fontface->bitmap_lru);
 
     fontface->files = heap_alloc_zero(sizeof(*fontface->files) * desc->files_number);
     if (!fontface->files) {
@@ -4950,6 +5258,148 @@ static UINT32 get_glyph_bitmap_pitch(DWRITE_RENDERING_MODE1 rendering_mode, INT
     return rendering_mode == DWRITE_RENDERING_MODE1_ALIASED ? ((width + 31) >> 5) << 2 : (width + 3) / 4 * 4;
 }
 
+static struct glyph_bitmap_size *fontface_find_bitmap_size(struct dwrite_fontface *fontface,
+        const struct dwrite_glyphbitmap *bitmap, DWRITE_RENDERING_MODE1 rendering_mode)
+{
+    struct glyph_bitmap_size *size;
+
+    LIST_FOR_EACH_ENTRY(size, &fontface->bitmap_sizes, struct glyph_bitmap_size, entry) {
+        if (size->emsize == bitmap->emsize && size->rendering_mode == rendering_mode &&
+                size->has_transform == !!bitmap->m &&
+                (!bitmap->m || !memcmp(&size->m, bitmap->m, sizeof(size->m))))
+            return size;
+    }
+
+    return NULL;
+}
+
+static struct glyph_bitmap *fontface_find_glyph_bitmap(struct dwrite_fontface *fontface,
+        const struct dwrite_glyphbitmap *bitmap, DWRITE_RENDERING_MODE1 rendering_mode)
+{
+    struct glyph_bitmap_size *size;
+    struct glyph_bitmap **block;
+
+    if (!(size = fontface_find_bitmap_size(fontface, bitmap, rendering_mode)))
+        return NULL;
+
+    if (!(block = size->glyphs[bitmap->index >> GLYPH_BLOCK_SHIFT]))
+        return NULL;
+
+    return block[bitmap->index & GLYPH_BLOCK_MASK];
+}
+
+static void fontface_add_glyph_bitmap(struct dwrite_fontface *fontface, const struct dwrite_glyphbitmap *bitmap,
+        DWRITE_RENDERING_MODE1 rendering_mode, struct glyph_bitmap *glyph)
+{
+    UINT32 data_size = get_glyph_bitmap_data_size(glyph);
+    struct glyph_bitmap_size *size;
+    struct glyph_bitmap ***block;
+
+    /* don't let a few huge glyphs flush the whole cache */
+    if (data_size > GLYPH_BITMAP_CACHE_MAX_SIZE / 16 || fontface_find_glyph_bitmap(fontface, bitmap, rendering_mode)) {
+        heap_free(glyph);
+        return;
+    }
+
+    while (fontface->bitmap_cache_size + data_size > GLYPH_BITMAP_CACHE_MAX_SIZE)
+        release_glyph_bitmap(fontface, LIST_ENTRY(list_tail(&fontface->bitmap_lru), struct glyph_bitmap, entry));
+
+    if (!(size = fontface_find_bitmap_size(fontface, bitmap, rendering_mode))) {
+        if (!(size = heap_alloc_zero(sizeof(*size)))) {
+            heap_free(glyph);
+            return;
+        }
+        size->emsize = bitmap->emsize;
+        size->has_transform = !!bitmap->m;
+        if (bitmap->m)
+            size->m = *bitmap->m;
+        size->rendering_mode = rendering_mode;
+        list_add_head(&fontface->bitmap_sizes, &size->entry);
+    }
+
+    block = &size->glyphs[glyph->index >> GLYPH_BLOCK_SHIFT];
+    if (!*block && !(*block = heap_alloc_zero(sizeof(**block) * GLYPH_BLOCK_SIZE))) {
+        if (!size->count)
+            release_glyph_bitmap_size(size);
+        heap_free(glyph);
+        return;
+    }
+
+    (*block)[glyph->index & GLYPH_BLOCK_MASK] = glyph;
+    glyph->size = size;
+    size->count++;
+    list_add_head(&fontface->bitmap_lru, &glyph->entry);
+    fontface->bitmap_cache_size += data_size;
+}
+
+static void fontface_get_glyph_bbox(struct dwrite_fontface *fontface, DWRITE_RENDERING_MODE1 rendering_mode,
+        struct dwrite_glyphbitmap *bitmap)
+{
+    struct glyph_bitmap *glyph;
+
+    EnterCriticalSection(&glyph_bitmap_cs);
+    glyph = fontface_find_glyph_bitmap(fontface, bitmap, rendering_mode);
+    if (glyph)
+        bitmap->bbox = glyph->bbox;
+    LeaveCriticalSection(&glyph_bitmap_cs);
+
+    if (!glyph)
+        freetype_get_glyph_bbox(bitmap);
+}
+
+/* Renders glyph to bitmap->buf, setting its box and pitch. Rendered glyphs are cached per fontface,
+   returns TRUE for 1bpp bitmaps. */
+static BOOL fontface_get_glyph_bitmap(struct dwrite_fontface *fontface, DWRITE_RENDERING_MODE1 rendering_mode,
+        struct dwrite_glyphbitmap *bitmap)
+{
+    struct glyph_bitmap *glyph;
+    UINT32 data_size;
+    BOOL is_1bpp;
+
+    EnterCriticalSection(&glyph_bitmap_cs);
+    if ((glyph = fontface_find_glyph_bitmap(fontface, bitmap, rendering_mode))) {
+        list_remove(&glyph->entry);
+        list_add_head(&fontface->bitmap_lru, &glyph->entry);
+        fontface->bitmap_hits++;
+
+        bitmap->bbox = glyph->bbox;
+        bitmap->pitch = glyph->pitch;
+        memcpy(bitmap->buf, glyph->bits, get_glyph_bitmap_data_size(glyph));
+        is_1bpp = glyph->is_1bpp;
+        LeaveCriticalSection(&glyph_bitmap_cs);
+        return is_1bpp;
+    }
+    fontface->bitmap_misses++;
+    LeaveCriticalSection(&glyph_bitmap_cs);
+
+    freetype_get_glyph_bbox(bitmap);
+
+    if (IsRectEmpty(&bitmap->bbox)) {
+        bitmap->pitch = 0;
+        is_1bpp = FALSE;
+    }
+    else {
+        bitmap->pitch = get_glyph_bitmap_pitch(rendering_mode, bitmap->bbox.right - bitmap->bbox.left);
+        memset(bitmap->buf, 0, (bitmap->bbox.bottom - bitmap->bbox.top) * bitmap->pitch);
+        is_1bpp = freetype_get_glyph_bitmap(bitmap);
+    }
+
+    data_size = bitmap->pitch * (bitmap->bbox.bottom - bitmap->bbox.top);
+    if ((glyph = heap_alloc(FIELD_OFFSET(struct glyph_bitmap, bits[data_size])))) {
+        glyph->index = bitmap->index;
+        glyph->is_1bpp = is_1bpp;
+        glyph->pitch = bitmap->pitch;
+        glyph->bbox = bitmap->bbox;
+        memcpy(glyph->bits, bitmap->buf, data_size);
+
+        EnterCriticalSection(&glyph_bitmap_cs);
+        fontface_add_glyph_bitmap(fontface, bitmap, rendering_mode, glyph);
+        LeaveCriticalSection(&glyph_bitmap_cs);
+    }
+
+    return is_1bpp;
+}
+
 static void glyphrunanalysis_get_texturebounds(struct dwrite_glyphrunanalysis *analysis, RECT *bounds)
 {
     struct dwrite_glyphbitmap glyph_bitmap;
@@ -4982,7 +5432,7 @@ static void glyphrunanalysis_get_texturebounds(struct dwrite_glyphrunanalysis *a
         UINT32 bitmap_size;
 
         glyph_bitmap.index = analysis->run.glyphIndices[i];
-        freetype_get_glyph_bbox(&glyph_bitmap);
+        fontface_get_glyph_bbox(impl_from_IDWriteFontFace4(fontface), analysis->rendering_mode, &glyph_bitmap);
 
         bitmap_size = get_glyph_bitmap_pitch(analysis->rendering_mode, bbox->right - bbox->left) *
             (bbox->bottom - bbox->top);
@@ -5083,7 +5533,8 @@ static HRESULT glyphrunanalysis_render(struct dwrite_glyphrunanalysis *analysis)
         BOOL is_1bpp;
 
         glyph_bitmap.index = analysis->run.glyphIndices[i];
-        freetype_get_glyph_bbox(&glyph_bitmap);
+        is_1bpp = fontface_get_glyph_bitmap(impl_from_IDWriteFontFace4(fontface), analysis->rendering_mode,
+                &glyph_bitmap);
 
         if (IsRectEmpty(bbox))
             continue;
@@ -5091,10 +5542,6 @@ static HRESULT glyphrunanalysis_render(struct dwrite_glyphrunanalysis *analysis)
         width = bbox->right - bbox->left;
         height = bbox->bottom - bbox->top;
 
-        glyph_bitmap.pitch = get_glyph_bitmap_pitch(analysis->rendering_mode, width);
-        memset(src, 0, height * glyph_bitmap.pitch);
-        is_1bpp = freetype_get_glyph_bitmap(&glyph_bitmap);
-
         OffsetRect(bbox, analysis->origins[i].x, analysis->origins[i].y);
 
         /* blit to analysis bitmap */
@@ -2577,6 +2577,21 @@ static inline HRESULT return_range(const struct layout_range_header *h, DWRITE_T
     return S_OK;
 }
 
+/* Drawing effects and decorations are only used to split effective runs, so changing them
+   doesn't require text to be analyzed and shaped again. */
+static USHORT get_layout_range_attr_recompute(enum layout_range_attr_kind attr)
+{
+    switch (attr)
+    {
+    case LAYOUT_RANGE_ATTR_EFFECT:
+    case LAYOUT_RANGE_ATTR_UNDERLINE:
+    case LAYOUT_RANGE_ATTR_STRIKETHROUGH:
+        return RECOMPUTE_LINES_AND_OVERHANGS;
+    default:
+        return RECOMPUTE_EVERYTHING;
+    }
+}
+
 /* Sets attribute value for given range, does all needed splitting/merging of existing ranges. */
 static HRESULT set_layout_range_attr(struct dwrite_textlayout *layout, enum layout_range_attr_kind attr, struct layout_range_attr_value *value)
 {
@@ -2681,7 +2696,7 @@ static HRESULT set_layout_range_attr(struct dwrite_textlayout *layout, enum layo
         list_add_after(&outer->entry, &cur->entry);
         list_add_after(&cur->entry, &right->entry);
 
-        layout->recompute = RECOMPUTE_EVERYTHING;
+        layout->recompute |= get_layout_range_attr_recompute(attr);
         return S_OK;
     }
 
@@ -2721,7 +2736,7 @@ done:
     if (changed) {
         struct list *next, *i;
 
-        layout->recompute = RECOMPUTE_EVERYTHING;
+        layout->recompute |= get_layout_range_attr_recompute(attr);
         i = list_head(ranges);
         while ((next = list_next(ranges, i))) {
             struct layout_range_header *next_range = LIST_ENTRY(next, struct layout_range_header, entry);
@@ -2276,6 +2276,8 @@ static void test_system_fontcollection(void)
     hr = IDWriteFactory_GetSystemFontCollection(factory2, &coll2, FALSE);
     ok(hr == S_OK, "got 0x%08x\n", hr);
     ok(coll2 != collection, "got %p, was %p\n", coll2, collection);
+    i = IDWriteFontCollection_GetFontFamilyCount(coll2);
+    ok(i == IDWriteFontCollection_GetFontFamilyCount(collection), "got %u\n", i);
     IDWriteFontCollection_Release(coll2);
     IDWriteFactory_Release(factory2);
 
@@ -6424,7 +6426,7 @@ static void test_CreateAlphaTexture(void)
     IDWriteFactory *factory;
     DWRITE_GLYPH_RUN run;
     UINT32 ch, size;
-    BYTE buff[1024];
+    BYTE buff[1024], buff2[1024];
     RECT bounds, r;
     FLOAT advance;
     UINT16 glyph;
@@ -6552,6 +6554,27 @@ static void test_CreateAlphaTexture(void)
     ok(hr == DWRITE_E_UNSUPPORTEDOPERATION || broken(hr == S_OK), "got 0x%08x\n", hr);
     ok(buff[0] == 0xcf || broken(buff[0] == 0), "got %1x\n", buff[0]);
 
+    memset(buff, 0xcf, sizeof(buff));
+    hr = IDWriteGlyphRunAnalysis_CreateAlphaTexture(analysis, DWRITE_TEXTURE_ALIASED_1x1, &bounds, buff, size);
+    ok(hr == S_OK, "got 0x%08x\n", hr);
+    IDWriteGlyphRunAnalysis_Release(analysis);
+
+    /* same run rendered again */
+    hr = IDWriteFactory_CreateGlyphRunAnalysis(factory, &run, 1.0, NULL,
+        DWRITE_RENDERING_MODE_ALIASED, DWRITE_MEASURING_MODE_GDI_CLASSIC,
+        0.0, 0.0, &analysis);
+    ok(hr == S_OK, "got 0x%08x\n", hr);
+
+    SetRectEmpty(&r);
+    hr = IDWriteGlyphRunAnalysis_GetAlphaTextureBounds(analysis, DWRITE_TEXTURE_ALIASED_1x1, &r);
+    ok(hr == S_OK, "got 0x%08x\n", hr);
+    ok(EqualRect(&r, &bounds), "got %s, expected %s\n", wine_dbgstr_rect(&r), wine_dbgstr_rect(&bounds));
+
+    memset(buff2, 0xcf, sizeof(buff2));
+    hr = IDWriteGlyphRunAnalysis_CreateAlphaTexture(analysis, DWRITE_TEXTURE_ALIASED_1x1, &bounds, buff2, size);
+    ok(hr == S_OK, "got 0x%08x\n", hr);
+    ok(!memcmp(buff, buff2, size), "got different texture\n");
+
     IDWriteGlyphRunAnalysis_Release(analysis);
     IDWriteFontFace_Release(fontface);
     ref = IDWriteFactory_Release(factory);
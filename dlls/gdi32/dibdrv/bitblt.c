@@ -21,6 +21,7 @@
 #include <assert.h>
 
 #include "gdi_private.h"
+#include "winreg.h"
 #include "dibdrv.h"
 
 #include "wine/debug.h"
@@ -581,6 +582,112 @@ static void mask_rect( dib_info *dst, const RECT *dst_rect, const dib_info *src,
     }
 }
 
+/* Large blends are split in row bands that are processed in parallel by the
+ * thread pool. Rows are independent, so the result is the same as when
+ * blending on the calling thread. */
+#define MIN_PARALLEL_BLEND_PIXELS (256 * 1024)
+#define MIN_BLEND_BAND_ROWS 16
+#define MAX_BLEND_BANDS 16
+
+struct blend_band
+{
+    dib_info *dst;
+    const dib_info *src;
+    RECT rect;
+    POINT origin;
+    BLENDFUNCTION blend;
+};
+
+#define IS_OPTION_TRUE(ch) ((ch) == 'y' || (ch) == 'Y' || (ch) == 't' || (ch) == 'T' || (ch) == '1')
+
+static INIT_ONCE blend_bands_init_once = INIT_ONCE_STATIC_INIT;
+static int max_bands;
+
+static BOOL CALLBACK init_blend_bands( INIT_ONCE *once, void *param, void **context )
+{
+    static const WCHAR gdiW[] = {'S','o','f','t','w','a','r','e','\\','W','i','n','e','\\','G','D','I',0};
+    static const WCHAR parallelW[] = {'P','a','r','a','l','l','e','l','R','e','n','d','e','r','i','n','g',0};
+    SYSTEM_INFO info;
+    WCHAR buffer[4];
+    DWORD type, count = sizeof(buffer);
+    HKEY key;
+
+    GetSystemInfo( &info );
+    max_bands = min( info.dwNumberOfProcessors, MAX_BLEND_BANDS );
+    if (!RegOpenKeyW( HKEY_CURRENT_USER, gdiW, &key ))
+    {
+        if (!RegQueryValueExW( key, parallelW, NULL, &type, (BYTE *)buffer, &count ) &&
+            type == REG_SZ && !IS_OPTION_TRUE( buffer[0] ))
+            max_bands = 1;
+        RegCloseKey( key );
+    }
+    TRACE( "using up to %d bands\n", max_bands );
+    return TRUE;
+}
+
+static int get_blend_band_count( const dib_info *dst, const RECT *rect, const dib_info *src )
+{
+    int width = rect->right - rect->left, height = rect->bottom - rect->top;
+
+    if (width * height < MIN_PARALLEL_BLEND_PIXELS) return 1;
+    InitOnceExecuteOnce( &blend_bands_init_once, init_blend_bands, NULL, NULL );
+    if (max_bands <= 1 || width * height < MIN_PARALLEL_BLEND_PIXELS) return 1;
+    /* overlapping source and destination need to be processed in order */
+    if (dst->bits.ptr == src->bits.ptr) return 1;
+    return max( 1, min( max_bands, height / MIN_BLEND_BAND_ROWS ));
+}
+
+static void blend_band_rect( struct blend_band *band )
+{
+    band->dst->funcs->blend_rect( band->dst, &band->rect, band->src, &band->origin, band->blend );
+}
+
+static void CALLBACK blend_band_callback( TP_CALLBACK_INSTANCE *instance, void *context )
+{
+    blend_band_rect( context );
+}
+
+static void blend_rect_bands( dib_info *dst, const RECT *rect, const dib_info *src, const POINT *origin,
+                              BLENDFUNCTION blend )
+{
+    struct blend_band bands[MAX_BLEND_BANDS];
+    int i, count = get_blend_band_count( dst, rect, src ), height = rect->bottom - rect->top;
+    TP_CALLBACK_ENVIRON environment;
+    TP_CLEANUP_GROUP *group = NULL;
+
+    if (count > 1 && !(group = CreateThreadpoolCleanupGroup())) count = 1;
+
+    for (i = 0; i < count; i++)
+    {
+        bands[i].dst = dst;
+        bands[i].src = src;
+        bands[i].rect = *rect;
+        bands[i].rect.top = rect->top + MulDiv( height, i, count );
+        bands[i].rect.bottom = rect->top + MulDiv( height, i + 1, count );
+        bands[i].origin.x = origin->x;
+        bands[i].origin.y = origin->y + bands[i].rect.top - rect->top;
+        bands[i].blend = blend;
+    }
+
+    /* the first band is processed on the calling thread */
+    memset( &environment, 0, sizeof(environment) );
+    environment.Version = 1;
+    environment.CleanupGroup = group;
+    for (i = 1; i < count; i++)
+    {
+        if (!TrySubmitThreadpoolCallback( blend_band_callback, &bands[i], &environment ))
+            blend_band_rect( &bands[i] );
+    }
+    blend_band_rect( &bands[0] );
+
+    if (group)
+    {
+        /* wait for the other bands */
+        CloseThreadpoolCleanupGroupMembers( group, FALSE, NULL );
+        CloseThreadpoolCleanupGroup( group );
+    }
+}
+
 static DWORD blend_rect( dib_info *dst, const RECT *dst_rect, const dib_info *src, const RECT *src_rect,
                          HRGN clip, BLENDFUNCTION blend )
 {
@@ -593,7 +700,7 @@ static DWORD blend_rect( dib_info *dst, const RECT *dst_rect, const dib_info *sr
     {
         origin.x = src_rect->left + clipped_rects.rects[i].left - dst_rect->left;
         origin.y = src_rect->top  + clipped_rects.rects[i].top  - dst_rect->top;
-        dst->funcs->blend_rect( dst, &clipped_rects.rects[i], src, &origin, blend );
+        blend_rect_bands( dst, &clipped_rects.rects[i], src, &origin, blend );
     }
     free_clipped_rects( &clipped_rects );
     return ERROR_SUCCESS;
@@ -4615,6 +4615,11 @@ static inline DWORD blend_argb( DWORD dst, DWORD src )
     BYTE g = (BYTE)(src >> 8);
     BYTE r = (BYTE)(src >> 16);
     DWORD alpha  = (BYTE)(src >> 24);
+
+    /* fully opaque and fully transparent pixels are the common case,
+     * and the blend leaves respectively the source or the destination */
+    if (alpha == 255) return src;
+    if (!src) return dst;
     return ((b     + ((BYTE)dst         * (255 - alpha) + 127) / 255) |
             (g     + ((BYTE)(dst >> 8)  * (255 - alpha) + 127) / 255) << 8 |
             (r     + ((BYTE)(dst >> 16) * (255 - alpha) + 127) / 255) << 16 |
@@ -4623,9 +4628,12 @@ static inline DWORD blend_argb( DWORD dst, DWORD src )
 
 static inline DWORD blend_argb_alpha( DWORD dst, DWORD src, DWORD alpha )
 {
-    BYTE b = ((BYTE)src         * alpha + 127) / 255;
-    BYTE g = ((BYTE)(src >> 8)  * alpha + 127) / 255;
-    BYTE r = ((BYTE)(src >> 16) * alpha + 127) / 255;
+    BYTE b, g, r;
+
+    if (!src) return dst;
+    b = ((BYTE)src         * alpha + 127) / 255;
+    g = ((BYTE)(src >> 8)  * alpha + 127) / 255;
+    r = ((BYTE)(src >> 16) * alpha + 127) / 255;
     alpha  = ((BYTE)(src >> 24) * alpha + 127) / 255;
     return ((b     + ((BYTE)dst         * (255 - alpha) + 127) / 255) |
             (g     + ((BYTE)(dst >> 8)  * (255 - alpha) + 127) / 255) << 8 |
@@ -569,6 +569,7 @@ typedef struct tagFontSubst {
 static const WCHAR wine_fonts_key[] = {'S','o','f','t','w','a','r','e','\\','W','i','n','e','\\',
                                        'F','o','n','t','s',0};
 static const WCHAR wine_fonts_cache_key[] = {'C','a','c','h','e',0};
+static const WCHAR wine_fonts_files_key[] = {'F','i','l','e','s',0};
 static const WCHAR english_name_value[] = {'E','n','g','l','i','s','h',' ','N','a','m','e',0};
 static const WCHAR face_index_value[] = {'I','n','d','e','x',0};
 static const WCHAR face_ntmflags_value[] = {'N','t','m','f','l','a','g','s',0};
@@ -599,6 +600,7 @@ static struct list mappings_list = LIST_INIT( mappings_list );
 
 static UINT default_aa_flags;
 static HKEY hkey_font_cache;
+static HKEY hkey_font_files;
 static BOOL antialias_fakes = TRUE;
 
 static CRITICAL_SECTION freetype_cs;
@@ -1920,14 +1922,12 @@ static void get_family_names( FT_Face ft_face, WCHAR **name, WCHAR **english, BO
     }
 }
 
-static Family *get_family( FT_Face ft_face, BOOL vertical )
+/****************************************************************
+ * NB This function takes ownership of the name strings.
+ */
+static Family *get_family_from_names( WCHAR *name, WCHAR *english_name )
 {
-    Family *family;
-    WCHAR *name, *english_name;
-
-    get_family_names( ft_face, &name, &english_name, vertical );
-
-    family = find_family_from_name( name );
+    Family *family = find_family_from_name( name );
 
     if (!family)
     {
@@ -1952,6 +1952,14 @@ static Family *get_family( FT_Face ft_face, BOOL vertical )
     return family;
 }
 
+static Family *get_family( FT_Face ft_face, BOOL vertical )
+{
+    WCHAR *name, *english_name;
+
+    get_family_names( ft_face, &name, &english_name, vertical );
+    return get_family_from_names( name, english_name );
+}
+
 static inline FT_Fixed get_font_version( FT_Face ft_face )
 {
     FT_Fixed version = 0;
@@ -2135,23 +2143,11 @@ static Face *create_face( FT_Face ft_face, FT_Long face_index, const char *file,
     return face;
 }
 
-static void AddFaceToList(FT_Face ft_face, const char *file, void *font_data_ptr, DWORD font_data_size,
-                          FT_Long face_index, DWORD flags )
+static void add_face_to_family( Face *face, Family *family, DWORD flags )
 {
-    Face *face;
-    Family *family;
-
-    face = create_face( ft_face, face_index, file, font_data_ptr, font_data_size, flags );
-    family = get_family( ft_face, flags & ADDFONT_VERTICAL_FONT );
     if (strlenW(family->FamilyName) >= LF_FACESIZE)
-    {
         WARN("Ignoring %s because name is too long\n", debugstr_w(family->FamilyName));
-        release_face( face );
-        release_family( family );
-        return;
-    }
-
-    if (insert_face_in_family_list( face, family ))
+    else if (insert_face_in_family_list( face, family ))
     {
         if (flags & ADDFONT_ADD_TO_CACHE)
             add_face_to_cache( face );
@@ -2163,6 +2159,293 @@ static void AddFaceToList(FT_Face ft_face, const char *file, void *font_data_ptr
     release_family( family );
 }
 
+/* Persistent cache of the faces found in font files, so that the font list can be
+ * rebuilt without loading every font file through FreeType.  Each file is stored as
+ * a binary value named after its path, and is ignored when the file size or
+ * modification time, the FreeType version or the system locale have changed. */
+
+#define FONT_FILE_CACHE_VERSION 1
+
+struct font_file_cache_header
+{
+    DWORD     version;
+    DWORD     ft_version;
+    LCID      lcid;
+    DWORD     num_faces;
+    ULONGLONG size;
+    ULONGLONG mtime;
+};
+
+enum font_file_cache_name
+{
+    CACHE_FAMILY_NAME,
+    CACHE_ENGLISH_NAME,
+    CACHE_STYLE_NAME,
+    CACHE_FULL_NAME,
+    CACHE_NAME_COUNT
+};
+
+struct font_file_cache_face
+{
+    DWORD         record_size;  /* including the names, rounded up to a DWORD */
+    DWORD         face_index;
+    DWORD         flags;        /* ADDFONT_VERTICAL_FONT */
+    DWORD         ntm_flags;
+    DWORD         font_version;
+    FONTSIGNATURE fs;
+    WORD          name_len[CACHE_NAME_COUNT];  /* in WCHARs including the terminator, 0 if not present */
+    /* followed by the names */
+};
+
+struct font_file_cache_entry
+{
+    BYTE *data;
+    DWORD size;
+    DWORD alloc;
+    BOOL  valid;
+};
+
+static void init_font_file_cache_entry( struct font_file_cache_entry *entry, const struct stat *st )
+{
+    struct font_file_cache_header *header;
+
+    entry->alloc = 1024;
+    entry->size = sizeof(*header);
+    entry->valid = (entry->data = HeapAlloc( GetProcessHeap(), 0, entry->alloc )) != NULL;
+    if (!entry->valid) return;
+
+    header = (struct font_file_cache_header *)entry->data;
+    header->version = FONT_FILE_CACHE_VERSION;
+    header->ft_version = FT_SimpleVersion;
+    header->lcid = GetSystemDefaultLCID();
+    header->num_faces = 0;
+    header->size = st->st_size;
+    header->mtime = st->st_mtime;
+}
+
+static void add_face_to_font_file_cache_entry( struct font_file_cache_entry *entry, const Face *face,
+                                               const Family *family )
+{
+    const WCHAR *names[CACHE_NAME_COUNT];
+    struct font_file_cache_face *record;
+    DWORD i, size = sizeof(*record);
+    WCHAR *ptr;
+
+    if (!entry->valid) return;
+
+    /* bitmap fonts are accepted or not depending on ADDFONT_ALLOW_BITMAP, don't bother with them */
+    if (!face->scalable)
+    {
+        entry->valid = FALSE;
+        return;
+    }
+
+    names[CACHE_FAMILY_NAME] = family->FamilyName;
+    names[CACHE_ENGLISH_NAME] = family->EnglishName;
+    names[CACHE_STYLE_NAME] = face->StyleName;
+    names[CACHE_FULL_NAME] = face->FullName;
+    for (i = 0; i < CACHE_NAME_COUNT; i++)
+        if (names[i]) size += (strlenW( names[i] ) + 1) * sizeof(WCHAR);
+    size = (size + 3) & ~3;
+
+    if (entry->size + size > entry->alloc)
+    {
+        DWORD new_alloc = max( entry->alloc * 2, entry->size + size );
+        BYTE *new_data = HeapReAlloc( GetProcessHeap(), 0, entry->data, new_alloc );
+
+        if (!new_data)
+        {
+            entry->valid = FALSE;
+            return;
+        }
+        entry->data = new_data;
+        entry->alloc = new_alloc;
+    }
+
+    record = (struct font_file_cache_face *)(entry->data + entry->size);
+    memset( record, 0, size );
+    record->record_size = size;
+    record->face_index = face->face_index;
+    record->flags = face->flags & ADDFONT_VERTICAL_FONT;
+    record->ntm_flags = face->ntmFlags;
+    record->font_version = face->font_version;
+    record->fs = face->fs;
+
+    ptr = (WCHAR *)(record + 1);
+    for (i = 0; i < CACHE_NAME_COUNT; i++)
+    {
+        if (!names[i]) continue;
+        record->name_len[i] = strlenW( names[i] ) + 1;
+        memcpy( ptr, names[i], record->name_len[i] * sizeof(WCHAR) );
+        ptr += record->name_len[i];
+    }
+
+    entry->size += size;
+    ((struct font_file_cache_header *)entry->data)->num_faces++;
+}
+
+static void save_font_file_cache_entry( const char *file, struct font_file_cache_entry *entry )
+{
+    if (entry->valid && ((struct font_file_cache_header *)entry->data)->num_faces)
+    {
+        WCHAR *nameW = towstr( CP_UNIXCP, file );
+        RegSetValueExW( hkey_font_files, nameW, 0, REG_BINARY, entry->data, entry->size );
+        HeapFree( GetProcessHeap(), 0, nameW );
+    }
+    HeapFree( GetProcessHeap(), 0, entry->data );
+}
+
+static const struct font_file_cache_face *get_font_file_cache_face( const BYTE *data, DWORD size, DWORD *pos )
+{
+    const struct font_file_cache_face *record = (const struct font_file_cache_face *)(data + *pos);
+    const WCHAR *ptr;
+    DWORD i, names_size = 0;
+
+    if (size - *pos < sizeof(*record)) return NULL;
+    if (record->record_size < sizeof(*record) || record->record_size > size - *pos) return NULL;
+    if (record->record_size & 3) return NULL;
+    if (!record->name_len[CACHE_FAMILY_NAME] || !record->name_len[CACHE_STYLE_NAME]) return NULL;
+
+    for (i = 0; i < CACHE_NAME_COUNT; i++) names_size += record->name_len[i] * sizeof(WCHAR);
+    if (names_size > record->record_size - sizeof(*record)) return NULL;
+
+    ptr = (const WCHAR *)(record + 1);
+    for (i = 0; i < CACHE_NAME_COUNT; i++)
+    {
+        if (!record->name_len[i]) continue;
+        ptr += record->name_len[i];
+        if (ptr[-1]) return NULL;
+    }
+
+    *pos += record->record_size;
+    return record;
+}
+
+static INT load_font_file_from_cache( const char *file, const struct stat *st, DWORD flags )
+{
+    const struct font_file_cache_header *header;
+    const struct font_file_cache_face *record;
+    DWORD i, size = 0, pos;
+    WCHAR *nameW;
+    BYTE *data = NULL;
+    INT ret = 0;
+
+    nameW = towstr( CP_UNIXCP, file );
+    if (RegQueryValueExW( hkey_font_files, nameW, NULL, NULL, NULL, &size ) || size < sizeof(*header))
+        goto done;
+    if (!(data = HeapAlloc( GetProcessHeap(), 0, size ))) goto done;
+    if (RegQueryValueExW( hkey_font_files, nameW, NULL, NULL, data, &size )) goto done;
+
+    header = (const struct font_file_cache_header *)data;
+    if (header->version != FONT_FILE_CACHE_VERSION || header->ft_version != FT_SimpleVersion ||
+        header->lcid != GetSystemDefaultLCID() || !header->num_faces ||
+        header->size != (ULONGLONG)st->st_size || header->mtime != (ULONGLONG)st->st_mtime)
+    {
+        TRACE("Cached data for %s is out of date\n", debugstr_a(file));
+        goto done;
+    }
+
+    /* validate everything first, so that a damaged entry doesn't add half of a file */
+    for (i = 0, pos = sizeof(*header); i < header->num_faces; i++)
+    {
+        if (!get_font_file_cache_face( data, size, &pos ))
+        {
+            WARN("Invalid cached data for %s\n", debugstr_a(file));
+            goto done;
+        }
+    }
+
+    for (i = 0, pos = sizeof(*header); i < header->num_faces; i++)
+    {
+        const WCHAR *names[CACHE_NAME_COUNT], *ptr;
+        DWORD j, face_flags;
+        Family *family;
+        Face *face;
+
+        record = get_font_file_cache_face( data, size, &pos );
+        ptr = (const WCHAR *)(record + 1);
+        for (j = 0; j < CACHE_NAME_COUNT; j++)
+        {
+            names[j] = record->name_len[j] ? ptr : NULL;
+            ptr += record->name_len[j];
+        }
+
+        face = HeapAlloc( GetProcessHeap(), 0, sizeof(*face) );
+        face->refcount = 1;
+        face->StyleName = strdupW( names[CACHE_STYLE_NAME] );
+        face->FullName = names[CACHE_FULL_NAME] ? strdupW( names[CACHE_FULL_NAME] ) : NULL;
+        face->file = strdupW( nameW );
+        face->dev = st->st_dev;
+        face->ino = st->st_ino;
+        face->font_data_ptr = NULL;
+        face->font_data_size = 0;
+        face->face_index = record->face_index;
+        face->fs = record->fs;
+        face->ntmFlags = record->ntm_flags;
+        face->font_version = record->font_version;
+        face->scalable = TRUE;
+        memset( &face->size, 0, sizeof(face->size) );
+
+        face_flags = flags | (record->flags & ADDFONT_VERTICAL_FONT);
+        if (!HIWORD( face_flags )) face_flags |= ADDFONT_AA_FLAGS( default_aa_flags );
+        face->flags = face_flags;
+        face->family = NULL;
+        face->cached_enum_data = NULL;
+
+        family = get_family_from_names( strdupW( names[CACHE_FAMILY_NAME] ),
+                                        names[CACHE_ENGLISH_NAME] ? strdupW( names[CACHE_ENGLISH_NAME] ) : NULL );
+        add_face_to_family( face, family, face_flags );
+    }
+    ret = header->num_faces;
+    TRACE("Loaded %d faces of %s from the cache\n", ret, debugstr_a(file));
+
+done:
+    HeapFree( GetProcessHeap(), 0, data );
+    HeapFree( GetProcessHeap(), 0, nameW );
+    return ret;
+}
+
+/* remove the entries of font files that no longer exist */
+static void prune_font_file_cache(void)
+{
+    DWORD index = 0, len, max_len;
+    WCHAR *nameW;
+    char *file;
+    struct stat st;
+
+    if (RegQueryInfoKeyW( hkey_font_files, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                          &max_len, NULL, NULL, NULL ))
+        return;
+    if (!(nameW = HeapAlloc( GetProcessHeap(), 0, ++max_len * sizeof(WCHAR) ))) return;
+
+    len = max_len;
+    while (!RegEnumValueW( hkey_font_files, index, nameW, &len, NULL, NULL, NULL, NULL ))
+    {
+        file = strWtoA( CP_UNIXCP, nameW );
+        if (stat( file, &st ) == -1)
+        {
+            TRACE("Removing %s from the cache\n", debugstr_a(file));
+            RegDeleteValueW( hkey_font_files, nameW );
+        }
+        else index++;
+        HeapFree( GetProcessHeap(), 0, file );
+        len = max_len;
+    }
+    HeapFree( GetProcessHeap(), 0, nameW );
+}
+
+static void AddFaceToList(FT_Face ft_face, const char *file, void *font_data_ptr, DWORD font_data_size,
+                          FT_Long face_index, DWORD flags, struct font_file_cache_entry *cache_entry )
+{
+    Face *face;
+    Family *family;
+
+    face = create_face( ft_face, face_index, file, font_data_ptr, font_data_size, flags );
+    family = get_family( ft_face, flags & ADDFONT_VERTICAL_FONT );
+    if (cache_entry) add_face_to_font_file_cache_entry( cache_entry, face, family );
+    add_face_to_family( face, family, flags );
+}
+
 static FT_Face new_ft_face( const char *file, void *font_data_ptr, DWORD font_data_size,
                             FT_Long face_index, BOOL allow_bitmap )
 {
@@ -2243,6 +2526,8 @@ static INT AddFontToList(const char *file, void *font_data_ptr, DWORD font_data_
 {
     FT_Face ft_face;
     FT_Long face_index = 0, num_faces;
+    struct font_file_cache_entry cache_entry, *entry = NULL;
+    struct stat st;
     INT ret = 0;
 
     /* we always load external fonts from files - otherwise we would get a crash in update_reg_entries */
@@ -2269,34 +2554,48 @@ static INT AddFontToList(const char *file, void *font_data_ptr, DWORD font_data_
     }
 #endif /* HAVE_CARBON_CARBON_H */
 
+    if (file && hkey_font_files && (flags & ADDFONT_ADD_TO_CACHE) && !stat( file, &st ))
+    {
+        if ((ret = load_font_file_from_cache( file, &st, flags ))) return ret;
+        init_font_file_cache_entry( &cache_entry, &st );
+        entry = &cache_entry;
+    }
+
     do {
         const DWORD FS_DBCS_MASK = FS_JISJAPAN|FS_CHINESESIMP|FS_WANSUNG|FS_CHINESETRAD|FS_JOHAB;
         FONTSIGNATURE fs;
 
         ft_face = new_ft_face( file, font_data_ptr, font_data_size, face_index, flags & ADDFONT_ALLOW_BITMAP );
-        if (!ft_face) return 0;
+        if (!ft_face)
+        {
+            if (entry) HeapFree( GetProcessHeap(), 0, entry->data );
+            return 0;
+        }
 
         if(ft_face->family_name[0] == '.') /* Ignore fonts with names beginning with a dot */
         {
             TRACE("Ignoring %s since its family name begins with a dot\n", debugstr_a(file));
             pFT_Done_Face(ft_face);
+            if (entry) HeapFree( GetProcessHeap(), 0, entry->data );
             return 0;
         }
 
-        AddFaceToList(ft_face, file, font_data_ptr, font_data_size, face_index, flags);
+        AddFaceToList(ft_face, file, font_data_ptr, font_data_size, face_index, flags, entry);
         ++ret;
 
         get_fontsig(ft_face, &fs);
         if (fs.fsCsb[0] & FS_DBCS_MASK)
         {
             AddFaceToList(ft_face, file, font_data_ptr, font_data_size, face_index,
-                          flags | ADDFONT_VERTICAL_FONT);
+                          flags | ADDFONT_VERTICAL_FONT, entry);
             ++ret;
         }
 
 	num_faces = ft_face->num_faces;
 	pFT_Done_Face(ft_face);
     } while(num_faces > ++face_index);
+
+    if (entry) save_font_file_cache_entry( file, entry );
     return ret;
 }
 
@@ -4195,6 +4494,13 @@ static void init_font_list(void)
 
     delete_external_font_keys();
 
+    /* the font file cache is not volatile, it is reused when the font list is rebuilt */
+    if (!RegCreateKeyExW( HKEY_CURRENT_USER, wine_fonts_key, 0, NULL, 0, KEY_ALL_ACCESS, NULL, &hkey, NULL ))
+    {
+        RegCreateKeyExW( hkey, wine_fonts_files_key, 0, NULL, 0, KEY_ALL_ACCESS, NULL, &hkey_font_files, NULL );
+        RegCloseKey( hkey );
+    }
+
     /* load the system bitmap fonts */
     load_system_fonts();
 
@@ -4319,6 +4625,13 @@ static void init_font_list(void)
         }
         RegCloseKey(hkey);
     }
+
+    if (hkey_font_files)
+    {
+        prune_font_file_cache();
+        RegCloseKey( hkey_font_files );
+        hkey_font_files = NULL;
+    }
 }
 
 static BOOL move_to_front(const WCHAR *name)
@@ -411,6 +411,7 @@ static BOOL REGION_UnionRegion(WINEREGION *d, WINEREGION *s1, WINEREGION *s2);
 static BOOL REGION_SubtractRegion(WINEREGION *d, WINEREGION *s1, WINEREGION *s2);
 static BOOL REGION_XorRegion(WINEREGION *d, WINEREGION *s1, WINEREGION *s2);
 static BOOL REGION_UnionRectWithRegion(const RECT *rect, WINEREGION *rgn);
+static void REGION_SetExtents(WINEREGION *reg);
 
 /***********************************************************************
  *            get_region_type
@@ -970,6 +971,84 @@ static void translate( POINT *pt, UINT count, const XFORM *xform )
 }
 
 
+/***********************************************************************
+ *           is_region_data
+ *
+ * Check whether the rectangles are already in the form used by regions, i.e.
+ * y-x banded, with no touching rectangles in a band and no identical adjoining bands.
+ */
+static BOOL is_region_data( const RECT *rects, UINT count )
+{
+    UINT i, band_start = 0, prev_band_start = 0;
+
+    for (i = 0; i <= count; i++)
+    {
+        if (i < count)
+        {
+            if (rects[i].left >= rects[i].right || rects[i].top >= rects[i].bottom) return FALSE;
+            if (!i) continue;
+            if (rects[i].top == rects[i - 1].top)
+            {
+                if (rects[i].bottom != rects[i - 1].bottom) return FALSE;
+                if (rects[i].left <= rects[i - 1].right) return FALSE;
+                continue;
+            }
+            if (rects[i].top < rects[i - 1].bottom) return FALSE;
+        }
+
+        /* a new band starts at i, check that the previous two can't be coalesced */
+        if (band_start != prev_band_start &&
+            rects[prev_band_start].bottom == rects[band_start].top &&
+            band_start - prev_band_start == i - band_start)
+        {
+            UINT j;
+
+            for (j = 0; j < i - band_start; j++)
+                if (rects[prev_band_start + j].left != rects[band_start + j].left ||
+                    rects[prev_band_start + j].right != rects[band_start + j].right) break;
+            if (j == i - band_start) return FALSE;
+        }
+        prev_band_start = band_start;
+        band_start = i;
+    }
+    return TRUE;
+}
+
+/***********************************************************************
+ *           REGION_UnionRects
+ *
+ * Add an array of rectangles to an empty region. Large arrays are split in
+ * halves that are combined together, which is much faster than adding the
+ * rectangles one at a time.
+ */
+static BOOL REGION_UnionRects( WINEREGION *rgn, const RECT *rects, UINT count )
+{
+    WINEREGION first, second;
+    BOOL ret;
+    UINT i;
+
+    if (count <= RGN_DEFAULT_RECTS)
+    {
+        for (i = 0; i < count; i++)
+        {
+            if (rects[i].left < rects[i].right && rects[i].top < rects[i].bottom)
+            {
+                if (!REGION_UnionRectWithRegion( &rects[i], rgn )) return FALSE;
+            }
+        }
+        return TRUE;
+    }
+
+    init_region( &first, 0 );
+    init_region( &second, 0 );
+    ret = REGION_UnionRects( &first, rects, count / 2 ) &&
+          REGION_UnionRects( &second, rects + count / 2, count - count / 2 ) &&
+          REGION_UnionRegion( rgn, &first, &second );
+    destroy_region( &first );
+    destroy_region( &second );
+    return ret;
+}
+
 /***********************************************************************
  *           ExtCreateRegion   (GDI32.@)
  *
@@ -991,7 +1070,6 @@ HRGN WINAPI ExtCreateRegion( const XFORM* lpXform, DWORD dwCount, const RGNDATA*
 {
     HRGN hrgn = 0;
     WINEREGION *obj;
-    const RECT *pCurRect, *pEndRect;
 
     if (!rgndata)
     {
@@ -1038,14 +1116,15 @@ HRGN WINAPI ExtCreateRegion( const XFORM* lpXform, DWORD dwCount, const RGNDATA*
 
     if (!(obj = alloc_region( rgndata->rdh.nCount ))) return 0;
 
-    pEndRect = (const RECT *)rgndata->Buffer + rgndata->rdh.nCount;
-    for(pCurRect = (const RECT *)rgndata->Buffer; pCurRect < pEndRect; pCurRect++)
+    /* data from GetRegionData() can be used as is */
+    if (is_region_data( (const RECT *)rgndata->Buffer, rgndata->rdh.nCount ))
     {
-        if (pCurRect->left < pCurRect->right && pCurRect->top < pCurRect->bottom)
-        {
-            if (!REGION_UnionRectWithRegion( pCurRect, obj )) goto done;
-        }
+        memcpy( obj->rects, rgndata->Buffer, rgndata->rdh.nCount * sizeof(RECT) );
+        obj->numRects = rgndata->rdh.nCount;
+        REGION_SetExtents( obj );
     }
+    else if (!REGION_UnionRects( obj, (const RECT *)rgndata->Buffer, rgndata->rdh.nCount )) goto done;
+
     hrgn = alloc_gdi_handle( obj, OBJ_REGION, &region_funcs );
 
 done:
@@ -1102,7 +1181,7 @@ BOOL WINAPI RectInRegion( HRGN hrgn, const RECT *rect )
     WINEREGION *obj;
     BOOL ret = FALSE;
     RECT rc;
-    int i;
+    int i, y;
 
     /* swap the coordinates to make right >= left and bottom >= top */
     /* (region building rectangles are normalized the same way) */
@@ -1113,22 +1192,20 @@ BOOL WINAPI RectInRegion( HRGN hrgn, const RECT *rect )
     {
 	if ((obj->numRects > 0) && overlapping(&obj->extents, &rc))
 	{
-	    for (i = region_find_pt( obj, rc.left, rc.top, &ret ); !ret && i < obj->numRects; i++ )
-	    {
-	        if (obj->rects[i].bottom <= rc.top)
-		    continue;             /* not far enough down yet */
-
-		if (obj->rects[i].top >= rc.bottom)
-		    break;                /* too far down */
-
-		if (obj->rects[i].right <= rc.left)
-		    continue;              /* not far enough over yet */
-
-		if (obj->rects[i].left >= rc.right)
-		    continue;
+            /* look up the first rectangle right of rc.left in each band, instead of
+             * scanning all the rectangles of the bands */
+            for (y = rc.top; !ret; )
+            {
+                i = region_find_pt( obj, rc.left, y, NULL );
+                if (i >= obj->numRects || obj->rects[i].top >= rc.bottom) break;  /* too far down */
 
-		ret = TRUE;
-	    }
+                if (obj->rects[i].top > y)
+                    y = obj->rects[i].top;     /* y is between bands, look in the next one */
+                else if (obj->rects[i].left < rc.right)
+                    ret = TRUE;
+                else
+                    y = obj->rects[i].bottom;  /* nothing in this band, try the next one */
+            }
 	}
 	GDI_ReleaseObj(hrgn);
     }
@@ -291,6 +291,66 @@ static void test_ExtCreateRegion(void)
 
 }
 
+static void test_ExtCreateRegion_rects(void)
+{
+    static const RECT test_rect = { 35, 27, 37, 90 };
+    RGNDATA *data, *data2;
+    HRGN hrgn, hrgn2, tmp;
+    DWORD size, size2;
+    RECT *rects;
+    BOOL ret;
+    int i;
+
+    data = HeapAlloc(GetProcessHeap(), 0, sizeof(RGNDATAHEADER) + 1000 * sizeof(RECT));
+    data->rdh.dwSize = sizeof(data->rdh);
+    data->rdh.iType = RDH_RECTANGLES;
+    data->rdh.nCount = 1000;
+    data->rdh.nRgnSize = 1000 * sizeof(RECT);
+    SetRectEmpty(&data->rdh.rcBound);
+    rects = (RECT *)data->Buffer;
+
+    /* overlapping, touching and empty rectangles in no particular order */
+    hrgn2 = CreateRectRgn(0, 0, 0, 0);
+    for (i = 0; i < 1000; i++)
+    {
+        SetRect(&rects[i], (i * 37) % 200, (i * 53) % 300, (i * 37) % 200 + i % 17, (i * 53) % 300 + i % 11);
+        if (rects[i].left >= rects[i].right || rects[i].top >= rects[i].bottom) continue;
+        tmp = CreateRectRgnIndirect(&rects[i]);
+        CombineRgn(hrgn2, hrgn2, tmp, RGN_OR);
+        DeleteObject(tmp);
+    }
+
+    hrgn = ExtCreateRegion(NULL, sizeof(RGNDATAHEADER) + 1000 * sizeof(RECT), data);
+    ok(hrgn != 0, "ExtCreateRegion error %u\n", GetLastError());
+    ok(EqualRgn(hrgn, hrgn2), "regions don't match\n");
+
+    for (i = 0; i < 1000; i++)
+    {
+        ret = PtInRegion(hrgn, (i * 7) % 210, (i * 13) % 310);
+        ok(ret == PtInRegion(hrgn2, (i * 7) % 210, (i * 13) % 310), "%d: PtInRegion returned %d\n", i, ret);
+    }
+    ok(!RectInRegion(hrgn, &test_rect) == !RectInRegion(hrgn2, &test_rect), "RectInRegion results don't match\n");
+
+    /* region data can be passed back unchanged */
+    size = GetRegionData(hrgn, 0, NULL);
+    data2 = HeapAlloc(GetProcessHeap(), 0, size);
+    size2 = GetRegionData(hrgn, size, data2);
+    ok(size2 == size, "got %u, expected %u\n", size2, size);
+    DeleteObject(hrgn2);
+    hrgn2 = ExtCreateRegion(NULL, size, data2);
+    ok(hrgn2 != 0, "ExtCreateRegion error %u\n", GetLastError());
+    ok(EqualRgn(hrgn, hrgn2), "regions don't match\n");
+    data = HeapReAlloc(GetProcessHeap(), 0, data, size);
+    size2 = GetRegionData(hrgn2, size, data);
+    ok(size2 == size, "got %u, expected %u\n", size2, size);
+    ok(!memcmp(data->Buffer, data2->Buffer, data2->rdh.nCount * sizeof(RECT)), "rectangles don't match\n");
+
+    HeapFree(GetProcessHeap(), 0, data2);
+    HeapFree(GetProcessHeap(), 0, data);
+    DeleteObject(hrgn2);
+    DeleteObject(hrgn);
+}
+
 static void test_GetClipRgn(void)
 {
     HDC hdc;
@@ -538,6 +598,7 @@ START_TEST(clipping)
 {
     test_GetRandomRgn();
     test_ExtCreateRegion();
+    test_ExtCreateRegion_rects();
     test_GetClipRgn();
     test_memory_dc_clipping();
     test_window_dc_clipping();
@@ -3516,11 +3516,87 @@ static void test_simple_graphics(void)
     DeleteDC(mem_dc);
 }
 
+static HBITMAP create_blend_dib( HDC hdc, int width, int height, DWORD **bits )
+{
+    BITMAPINFO info;
+
+    memset( &info, 0, sizeof(info) );
+    info.bmiHeader.biSize        = sizeof(info.bmiHeader);
+    info.bmiHeader.biWidth       = width;
+    info.bmiHeader.biHeight      = -height;
+    info.bmiHeader.biPlanes      = 1;
+    info.bmiHeader.biBitCount    = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+    return CreateDIBSection( hdc, &info, DIB_RGB_COLORS, (void **)bits, NULL, 0 );
+}
+
+static void test_large_alpha_blend(void)
+{
+    static const BLENDFUNCTION blends[] =
+    {
+        { AC_SRC_OVER, 0, 0x8c, AC_SRC_ALPHA },
+        { AC_SRC_OVER, 0, 0xff, AC_SRC_ALPHA },
+        { AC_SRC_OVER, 0, 0x5a, 0 },
+    };
+    /* large enough to be blended in several bands */
+    const int width = 640, height = 480, strip = 8;
+    HDC src_dc, dst_dc, ref_dc;
+    HBITMAP src_bmp, dst_bmp, ref_bmp, orig_src, orig_dst, orig_ref;
+    DWORD *src_bits, *dst_bits, *ref_bits;
+    int i, x, y;
+
+    src_dc = CreateCompatibleDC( 0 );
+    dst_dc = CreateCompatibleDC( 0 );
+    ref_dc = CreateCompatibleDC( 0 );
+    src_bmp = create_blend_dib( src_dc, width, height, &src_bits );
+    dst_bmp = create_blend_dib( dst_dc, width, height, &dst_bits );
+    ref_bmp = create_blend_dib( ref_dc, width, height, &ref_bits );
+    orig_src = SelectObject( src_dc, src_bmp );
+    orig_dst = SelectObject( dst_dc, dst_bmp );
+    orig_ref = SelectObject( ref_dc, ref_bmp );
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < width; x++)
+        {
+            BYTE alpha = (x * 7 + y * 3) & 0xff;
+
+            src_bits[y * width + x] = (alpha << 24) | ((x * alpha / width) << 16) |
+                                      ((y * alpha / height) << 8) | (((x ^ y) & 0xff) * alpha / 255);
+        }
+    }
+
+    for (i = 0; i < sizeof(blends) / sizeof(blends[0]); i++)
+    {
+        for (y = 0; y < height; y++)
+            for (x = 0; x < width; x++)
+                dst_bits[y * width + x] = ref_bits[y * width + x] = (x << 16) ^ (y << 4) ^ (x * y);
+
+        GdiAlphaBlend( dst_dc, 0, 0, width, height, src_dc, 0, 0, width, height, blends[i] );
+        for (y = 0; y < height; y += strip)
+            GdiAlphaBlend( ref_dc, 0, y, width, strip, src_dc, 0, y, width, strip, blends[i] );
+
+        ok( !memcmp( dst_bits, ref_bits, width * height * sizeof(DWORD) ),
+            "%u: blend differs from the blend in strips\n", i );
+    }
+
+    SelectObject( src_dc, orig_src );
+    SelectObject( dst_dc, orig_dst );
+    SelectObject( ref_dc, orig_ref );
+    DeleteObject( src_bmp );
+    DeleteObject( dst_bmp );
+    DeleteObject( ref_bmp );
+    DeleteDC( src_dc );
+    DeleteDC( dst_dc );
+    DeleteDC( ref_dc );
+}
+
 START_TEST(dib)
 {
     CryptAcquireContextW(&crypt_prov, NULL, NULL, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT);
 
     test_simple_graphics();
+    test_large_alpha_blend();
 
     CryptReleaseContext(crypt_prov, 0);
 }
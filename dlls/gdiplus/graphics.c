@@ -369,6 +369,34 @@ static GpStatus alpha_blend_bmp_pixels(GpGraphics *graphics, INT dst_x, INT dst_
     GpBitmap *dst_bitmap = (GpBitmap*)graphics->image;
     INT x, y;
 
+    if (dst_bitmap->format == PixelFormat32bppARGB)
+    {
+        /* blend directly into the bitmap bits, this is what Get/SetPixel would do */
+        INT start_x = max(0, -dst_x), end_x = min(src_width, dst_bitmap->width - dst_x);
+        INT start_y = max(0, -dst_y), end_y = min(src_height, dst_bitmap->height - dst_y);
+
+        for (y=start_y; y<end_y; y++)
+        {
+            const ARGB *src_row = (const ARGB*)(src + src_stride * y);
+            ARGB *dst_row = (ARGB*)(dst_bitmap->bits + dst_bitmap->stride * (y+dst_y)) + dst_x;
+
+            for (x=start_x; x<end_x; x++)
+            {
+                ARGB src_color = src_row[x];
+
+                if (!(src_color & 0xff000000))
+                    continue;
+
+                if (fmt & PixelFormatPAlpha)
+                    dst_row[x] = color_over_fgpremult(dst_row[x], src_color);
+                else
+                    dst_row[x] = color_over(dst_row[x], src_color);
+            }
+        }
+
+        return Ok;
+    }
+
     for (y=0; y<src_height; y++)
     {
         for (x=0; x<src_width; x++)
@@ -1202,8 +1230,8 @@ static GpStatus brush_fill_pixels(GpGraphics *graphics, GpBrush *brush,
     {
         int x, y;
         GpSolidFill *fill = (GpSolidFill*)brush;
-        for (x=0; x<fill_area->Width; x++)
-            for (y=0; y<fill_area->Height; y++)
+        for (y=0; y<fill_area->Height; y++)
+            for (x=0; x<fill_area->Width; x++)
                 argb_pixels[x + y*cdwStride] = fill->color;
         return Ok;
     }
@@ -1216,8 +1244,8 @@ static GpStatus brush_fill_pixels(GpGraphics *graphics, GpBrush *brush,
         if (get_hatch_data(fill->hatchstyle, &hatch_data) != Ok)
             return NotImplemented;
 
-        for (x=0; x<fill_area->Width; x++)
-            for (y=0; y<fill_area->Height; y++)
+        for (y=0; y<fill_area->Height; y++)
+            for (x=0; x<fill_area->Width; x++)
             {
                 int hx, hy;
 
@@ -1269,6 +1297,23 @@ static GpStatus brush_fill_pixels(GpGraphics *graphics, GpBrush *brush,
 
             for (y=0; y<fill_area->Height; y++)
             {
+                if (y && y_delta == 0.0)
+                {
+                    /* horizontal gradient, all rows are the same */
+                    memcpy(&argb_pixels[y*cdwStride], argb_pixels, fill_area->Width * sizeof(ARGB));
+                    continue;
+                }
+
+                if (x_delta == 0.0)
+                {
+                    /* vertical gradient, the color only changes between rows */
+                    ARGB color = blend_line_gradient(fill, draw_points[0].X + y * y_delta);
+
+                    for (x=0; x<fill_area->Width; x++)
+                        argb_pixels[x + y*cdwStride] = color;
+                    continue;
+                }
+
                 for (x=0; x<fill_area->Width; x++)
                 {
                     REAL pos = draw_points[0].X + x * x_delta + y * y_delta;
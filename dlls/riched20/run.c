@@ -190,12 +190,18 @@ void ME_RunOfsFromCharOfs(ME_TextEditor *editor,
   nCharOfs = max(nCharOfs, 0);
   nCharOfs = min(nCharOfs, len);
 
-  /* Find the paragraph at the offset. */
-  next_item = editor->pBuffer->pFirst->member.para.next_para;
-  do {
-    item = next_item;
-    next_item = item->member.para.next_para;
-  } while (next_item->member.para.nCharOfs <= nCharOfs);
+  /* Find the paragraph at the offset. Most lookups are close to the
+   * selection, so start from its paragraph unless the document start or
+   * end is closer. */
+  item = editor->pCursors[0].pPara;
+  if (nCharOfs < item->member.para.nCharOfs / 2)
+    item = editor->pBuffer->pFirst->member.para.next_para;
+  else if (nCharOfs > item->member.para.nCharOfs + (len - item->member.para.nCharOfs) / 2)
+    item = editor->pBuffer->pLast->member.para.prev_para;
+  while (item->member.para.nCharOfs > nCharOfs)
+    item = item->member.para.prev_para;
+  while (item->member.para.next_para->member.para.nCharOfs <= nCharOfs)
+    item = item->member.para.next_para;
   assert(item->type == diParagraph);
   nCharOfs -= item->member.para.nCharOfs;
   if (ppPara) *ppPara = item;
@@ -146,6 +146,8 @@ typedef struct
 	INT tabs_count;
 	LPINT tabs;
 	LINEDEF *first_line_def;	/* linked list of (soft) linebreaks */
+	LINEDEF *line_hint;		/* first line reformatted by the last EDIT_BuildLineDefs_ML */
+	INT line_hint_index;		/* line number of line_hint */
 	HLOCAL hloc32W;			/* our unicode local memory block */
 	HLOCAL hloc32A;			/* alias for ANSI control receiving EM_GETHANDLE
 				   	   or EM_SETHANDLE */
@@ -510,6 +512,16 @@ static void EDIT_BuildLineDefs_ML(EDITSTATE *es, INT istart, INT iend, INT delta
 	previous_line = NULL;
 	current_line = es->first_line_def;
 
+	/* Skip the lines before the last reformatted one if the modification
+	 * is after it, which is what happens when appending text. */
+	if (es->line_hint && es->line_hint->ending != END_0 &&
+			istart >= es->line_hint->index + es->line_hint->length)
+	{
+		previous_line = es->line_hint;
+		current_line = previous_line->next;
+		line_index = es->line_hint_index + 1;
+	}
+
 	/* Find starting line. istart must lie inside an existing line or
 	 * at the end of buffer */
 	do {
@@ -540,6 +552,8 @@ static void EDIT_BuildLineDefs_ML(EDITSTATE *es, INT istart, INT iend, INT delta
 		current_line = previous_line;
 	}
 	start_line = current_line;
+	es->line_hint = start_line;
+	es->line_hint_index = line_index;
 
 	fw = es->format_rect.right - es->format_rect.left;
 	current_position = es->text + current_line->index;
@@ -2615,10 +2629,11 @@ static void EDIT_EM_ReplaceSel(EDITSTATE *es, BOOL can_undo, LPCWSTR lpsz_replac
 		/* now delete */
 		strcpyW(es->text + s, es->text + e);
                 text_buffer_changed(es);
+		tl -= e - s;
+		es->text_length = tl;
 	}
 	if (strl) {
 		/* there is an insertion */
-		tl = get_text_length(es);
 		TRACE("inserting stuff (tl %d, strl %d, selstart %d (%s), text %s)\n", tl, strl, s, debugstr_w(es->text + s), debugstr_w(es->text));
 		for (p = es->text + tl ; p >= es->text + s ; p--)
 			p[strl] = p[0];
@@ -2629,6 +2644,7 @@ static void EDIT_EM_ReplaceSel(EDITSTATE *es, BOOL can_undo, LPCWSTR lpsz_replac
 		else if(es->style & ES_LOWERCASE)
 			CharLowerBuffW(p, strl);
                 text_buffer_changed(es);
+		es->text_length = tl + strl;
 	}
 	if (es->style & ES_MULTILINE)
 	{
@@ -56,6 +56,11 @@ WINE_DECLARE_DEBUG_CHANNEL(key);
 
 #define MAX_PACK_COUNT 4
 
+/* bounds of the per-thread get_message reply buffer size; it follows the size of
+ * the last message received, so that large payloads don't need a second server call */
+#define MIN_MESSAGE_BUFFER_SIZE 256
+#define MAX_MESSAGE_BUFFER_SIZE 0x10000
+
 /* the various structures that can be sent in messages, in platform-independent layout */
 struct packed_CREATESTRUCTW
 {
@@ -2733,7 +2738,7 @@ static BOOL peek_message( MSG *msg, HWND hwnd, UINT first, UINT last, UINT flags
     struct received_message_info info, *old_info;
     unsigned int hw_id = 0;  /* id of previous hardware message */
     void *buffer;
-    size_t buffer_size = 256;
+    size_t buffer_size = max( thread_info->message_buffer_size, MIN_MESSAGE_BUFFER_SIZE );
     shmlocal_t *shm = wine_get_shmlocal();
 
     /* From time to time we are forced to do a wineserver call in
@@ -2787,8 +2792,15 @@ static BOOL peek_message( MSG *msg, HWND hwnd, UINT first, UINT last, UINT flags
         }
         SERVER_END_REQ;
 
-        if (res)
+        if (!res)
+        {
+            size_t hint = max( size, MIN_MESSAGE_BUFFER_SIZE );
+            if (hint <= MAX_MESSAGE_BUFFER_SIZE) thread_info->message_buffer_size = hint;
+        }
+        else
         {
+            /* shrink the hint back when there are no more large messages */
+            if (res != STATUS_BUFFER_OVERFLOW) thread_info->message_buffer_size /= 2;
             HeapFree( GetProcessHeap(), 0, buffer );
             if (res == STATUS_PENDING)
             {
@@ -1421,6 +1421,57 @@ static void test_edit_control_scroll(void)
     DestroyWindow (hwEdit);
 }
 
+static void test_edit_control_append(void)
+{
+    static const char line[] = "line\r\n";
+    HWND hwEdit;
+    LONG ret;
+    int i;
+
+    hwEdit = create_editcontrol(WS_VSCROLL | ES_MULTILINE | ES_AUTOVSCROLL | ES_AUTOHSCROLL, 0);
+    SetWindowTextA(hwEdit, "");
+
+    for (i = 0; i < 50; i++)
+    {
+        ret = SendMessageA(hwEdit, WM_GETTEXTLENGTH, 0, 0);
+        ok(ret == i * 6, "%d: got length %d\n", i, ret);
+        SendMessageA(hwEdit, EM_SETSEL, ret, ret);
+        SendMessageA(hwEdit, EM_REPLACESEL, FALSE, (LPARAM)line);
+    }
+
+    ret = SendMessageA(hwEdit, EM_GETLINECOUNT, 0, 0);
+    ok(ret == 51, "got %d lines\n", ret);
+    ret = SendMessageA(hwEdit, EM_LINEINDEX, 50, 0);
+    ok(ret == 300, "got line index %d\n", ret);
+    ret = SendMessageA(hwEdit, EM_LINEINDEX, 25, 0);
+    ok(ret == 150, "got line index %d\n", ret);
+
+    /* insert before the previously appended lines */
+    SendMessageA(hwEdit, EM_SETSEL, 0, 0);
+    SendMessageA(hwEdit, EM_REPLACESEL, FALSE, (LPARAM)"x\r\n");
+    ret = SendMessageA(hwEdit, EM_GETLINECOUNT, 0, 0);
+    ok(ret == 52, "got %d lines\n", ret);
+    ret = SendMessageA(hwEdit, EM_LINEINDEX, 51, 0);
+    ok(ret == 303, "got line index %d\n", ret);
+
+    /* replace a selection in the middle */
+    SendMessageA(hwEdit, EM_SETSEL, 153, 159);
+    SendMessageA(hwEdit, EM_REPLACESEL, FALSE, (LPARAM)"ab");
+    ret = SendMessageA(hwEdit, WM_GETTEXTLENGTH, 0, 0);
+    ok(ret == 299, "got length %d\n", ret);
+    ret = SendMessageA(hwEdit, EM_GETLINECOUNT, 0, 0);
+    ok(ret == 51, "got %d lines\n", ret);
+    ret = SendMessageA(hwEdit, EM_LINEINDEX, 50, 0);
+    ok(ret == 299, "got line index %d\n", ret);
+
+    SendMessageA(hwEdit, EM_SETSEL, 299, 299);
+    SendMessageA(hwEdit, EM_REPLACESEL, FALSE, (LPARAM)"end");
+    ret = SendMessageA(hwEdit, EM_LINELENGTH, 299, 0);
+    ok(ret == 3, "got line length %d\n", ret);
+
+    DestroyWindow(hwEdit);
+}
+
 static void test_margins_usefontinfo(UINT charset)
 {
     HWND hwnd;
@@ -2851,6 +2902,7 @@ START_TEST(edit)
     test_edit_control_6();
     test_edit_control_limittext();
     test_edit_control_scroll();
+    test_edit_control_append();
     test_margins();
     test_margins_font_change();
     test_text_position();
@@ -191,6 +191,7 @@ struct user_thread_info
     RAWINPUT                     *rawinput;
     HWND                          foreground_wnd;         /* Cache of the foreground window */
     DWORD                         foreground_wnd_epoch;   /* Counter to invalidate foreground window */
+    DWORD                         message_buffer_size;    /* Size hint for the get_message reply buffer */
 };
 
 C_ASSERT( sizeof(struct user_thread_info) <= sizeof(((TEB *)0)->Win32ClientInfo) );
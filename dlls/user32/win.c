@@ -58,6 +58,31 @@ static CRITICAL_SECTION_DEBUG critsect_debug =
 };
 static CRITICAL_SECTION surfaces_section = { &critsect_debug, -1, 0, 0, 0, 0 };
 
+/* information about windows of other processes, valid as long as the server epoch doesn't change */
+#define WINDOW_INFO_STYLES 0x01  /* styles, id, instance and user data */
+#define WINDOW_INFO_TREE   0x02  /* parent and owner */
+#define WINDOW_INFO_RECTS  0x04  /* window and client rectangles */
+
+struct window_info
+{
+    HWND                 hwnd;
+    DWORD                epoch;
+    UINT                 valid;
+    DWORD                style;
+    DWORD                ex_style;
+    UINT                 id;
+    HINSTANCE            instance;
+    ULONG_PTR            user_data;
+    HWND                 parent;
+    HWND                 owner;
+    enum coords_relative relative;
+    RECT                 window;
+    RECT                 client;
+};
+
+#define WINDOW_INFO_CACHE_SIZE 64
+static struct window_info window_info_cache[WINDOW_INFO_CACHE_SIZE];
+
 /**********************************************************************/
 
 /* helper for Get/SetWindowLong */
@@ -810,6 +835,109 @@ ULONG WIN_SetStyle( HWND hwnd, ULONG set_bits, ULONG clear_bits )
 }
 
 
+/***********************************************************************
+ *           get_cached_window_info
+ *
+ * Retrieve the cached information of a window. The current epoch is returned
+ * in all cases, to be passed to set_cached_window_info after a server call.
+ */
+static BOOL get_cached_window_info( HWND hwnd, UINT mask, struct window_info *info, DWORD *epoch )
+{
+    shmglobal_t *shm = wine_get_shmglobal();
+    struct window_info *entry = &window_info_cache[LOWORD(hwnd) % WINDOW_INFO_CACHE_SIZE];
+    BOOL ret = FALSE;
+
+    if (!shm) return FALSE;
+    *epoch = shm->window_info_epoch;
+
+    USER_Lock();
+    if (entry->hwnd == hwnd && entry->epoch == *epoch && (entry->valid & mask) == mask)
+    {
+        *info = *entry;
+        ret = TRUE;
+    }
+    USER_Unlock();
+    return ret;
+}
+
+
+/***********************************************************************
+ *           set_cached_window_info
+ */
+static void set_cached_window_info( HWND hwnd, UINT mask, const struct window_info *info, DWORD epoch )
+{
+    struct window_info *entry = &window_info_cache[LOWORD(hwnd) % WINDOW_INFO_CACHE_SIZE];
+
+    if (!wine_get_shmglobal()) return;
+
+    USER_Lock();
+    if (entry->hwnd != hwnd || entry->epoch != epoch)
+    {
+        entry->hwnd  = hwnd;
+        entry->epoch = epoch;
+        entry->valid = 0;
+    }
+    if (mask & WINDOW_INFO_STYLES)
+    {
+        entry->style     = info->style;
+        entry->ex_style  = info->ex_style;
+        entry->id        = info->id;
+        entry->instance  = info->instance;
+        entry->user_data = info->user_data;
+    }
+    if (mask & WINDOW_INFO_TREE)
+    {
+        entry->parent = info->parent;
+        entry->owner  = info->owner;
+    }
+    if (mask & WINDOW_INFO_RECTS)
+    {
+        entry->relative = info->relative;
+        entry->window   = info->window;
+        entry->client   = info->client;
+    }
+    entry->valid |= mask;
+    USER_Unlock();
+}
+
+
+/***********************************************************************
+ *           get_window_tree_info
+ *
+ * Retrieve the parent and owner of a window from the server.
+ */
+static BOOL get_window_tree_info( HWND hwnd, HWND *parent, HWND *owner )
+{
+    struct window_info info;
+    DWORD epoch = 0;
+    BOOL ret;
+
+    if (get_cached_window_info( hwnd, WINDOW_INFO_TREE, &info, &epoch ))
+    {
+        *parent = info.parent;
+        *owner  = info.owner;
+        return TRUE;
+    }
+
+    SERVER_START_REQ( get_window_tree )
+    {
+        req->handle = wine_server_user_handle( hwnd );
+        if ((ret = !wine_server_call_err( req )))
+        {
+            info.parent = wine_server_ptr_handle( reply->parent );
+            info.owner  = wine_server_ptr_handle( reply->owner );
+        }
+    }
+    SERVER_END_REQ;
+
+    if (!ret) return FALSE;
+    set_cached_window_info( hwnd, WINDOW_INFO_TREE, &info, epoch );
+    *parent = info.parent;
+    *owner  = info.owner;
+    return TRUE;
+}
+
+
 /***********************************************************************
  *           WIN_GetRectangles
  *
@@ -917,29 +1045,36 @@ BOOL WIN_GetRectangles( HWND hwnd, enum coords_relative relative, RECT *rectWind
     }
 
 other_process:
-    SERVER_START_REQ( get_window_rectangles )
     {
-        req->handle = wine_server_user_handle( hwnd );
-        req->relative = relative;
-        if ((ret = !wine_server_call_err( req )))
+        struct window_info info;
+        DWORD epoch = 0;
+
+        if (!get_cached_window_info( hwnd, WINDOW_INFO_RECTS, &info, &epoch ) || info.relative != relative)
         {
-            if (rectWindow)
+            SERVER_START_REQ( get_window_rectangles )
             {
-                rectWindow->left   = reply->window.left;
-                rectWindow->top    = reply->window.top;
-                rectWindow->right  = reply->window.right;
-                rectWindow->bottom = reply->window.bottom;
-            }
-            if (rectClient)
-            {
-                rectClient->left   = reply->client.left;
-                rectClient->top    = reply->client.top;
-                rectClient->right  = reply->client.right;
-                rectClient->bottom = reply->client.bottom;
+                req->handle = wine_server_user_handle( hwnd );
+                req->relative = relative;
+                if ((ret = !wine_server_call_err( req )))
+                {
+                    info.relative      = relative;
+                    info.window.left   = reply->window.left;
+                    info.window.top    = reply->window.top;
+                    info.window.right  = reply->window.right;
+                    info.window.bottom = reply->window.bottom;
+                    info.client.left   = reply->client.left;
+                    info.client.top    = reply->client.top;
+                    info.client.right  = reply->client.right;
+                    info.client.bottom = reply->client.bottom;
+                }
             }
+            SERVER_END_REQ;
+            if (!ret) return FALSE;
+            set_cached_window_info( hwnd, WINDOW_INFO_RECTS, &info, epoch );
         }
+        if (rectWindow) *rectWindow = info.window;
+        if (rectClient) *rectClient = info.client;
     }
-    SERVER_END_REQ;
     return ret;
 }
 
@@ -2261,34 +2396,52 @@ static LONG_PTR WIN_GetWindowLong( HWND hwnd, INT offset, UINT size, BOOL unicod
 
     if (wndPtr == WND_OTHER_PROCESS)
     {
+        struct window_info info;
+        DWORD epoch = 0;
+        BOOL cached = FALSE;
+
         if (offset == GWLP_WNDPROC)
         {
             SetLastError( ERROR_ACCESS_DENIED );
             return 0;
         }
-        SERVER_START_REQ( set_window_info )
+        if (offset < 0) cached = get_cached_window_info( hwnd, WINDOW_INFO_STYLES, &info, &epoch );
+
+        if (!cached)
         {
-            req->handle = wine_server_user_handle( hwnd );
-            req->flags  = 0;  /* don't set anything, just retrieve */
-            req->extra_offset = (offset >= 0) ? offset : -1;
-            req->extra_size = (offset >= 0) ? size : 0;
-            if (!wine_server_call_err( req ))
+            SERVER_START_REQ( set_window_info )
             {
-                switch(offset)
+                req->handle = wine_server_user_handle( hwnd );
+                req->flags  = 0;  /* don't set anything, just retrieve */
+                req->extra_offset = (offset >= 0) ? offset : -1;
+                req->extra_size = (offset >= 0) ? size : 0;
+                if (!wine_server_call_err( req ))
                 {
-                case GWL_STYLE:      retvalue = reply->old_style; break;
-                case GWL_EXSTYLE:    retvalue = reply->old_ex_style; break;
-                case GWLP_ID:        retvalue = reply->old_id; break;
-                case GWLP_HINSTANCE: retvalue = (ULONG_PTR)wine_server_get_ptr( reply->old_instance ); break;
-                case GWLP_USERDATA:  retvalue = reply->old_user_data; break;
-                default:
+                    info.style     = reply->old_style;
+                    info.ex_style  = reply->old_ex_style;
+                    info.id        = reply->old_id;
+                    info.instance  = wine_server_get_ptr( reply->old_instance );
+                    info.user_data = reply->old_user_data;
                     if (offset >= 0) retvalue = get_win_data( &reply->old_extra_value, size );
-                    else SetLastError( ERROR_INVALID_INDEX );
-                    break;
+                    cached = TRUE;
                 }
             }
+            SERVER_END_REQ;
+            if (!cached || offset >= 0) return retvalue;
+            set_cached_window_info( hwnd, WINDOW_INFO_STYLES, &info, epoch );
+        }
+
+        switch(offset)
+        {
+        case GWL_STYLE:      retvalue = info.style; break;
+        case GWL_EXSTYLE:    retvalue = info.ex_style; break;
+        case GWLP_ID:        retvalue = info.id; break;
+        case GWLP_HINSTANCE: retvalue = (ULONG_PTR)info.instance; break;
+        case GWLP_USERDATA:  retvalue = info.user_data; break;
+        default:
+            SetLastError( ERROR_INVALID_INDEX );
+            break;
         }
-        SERVER_END_REQ;
         return retvalue;
     }
 
@@ -2930,18 +3083,12 @@ HWND WINAPI GetParent( HWND hwnd )
     if (wndPtr == WND_OTHER_PROCESS)
     {
         LONG style = GetWindowLongW( hwnd, GWL_STYLE );
-        if (style & (WS_POPUP | WS_CHILD))
+        HWND parent, owner;
+
+        if ((style & (WS_POPUP | WS_CHILD)) && get_window_tree_info( hwnd, &parent, &owner ))
         {
-            SERVER_START_REQ( get_window_tree )
-            {
-                req->handle = wine_server_user_handle( hwnd );
-                if (!wine_server_call_err( req ))
-                {
-                    if (style & WS_POPUP) retvalue = wine_server_ptr_handle( reply->owner );
-                    else if (style & WS_CHILD) retvalue = wine_server_ptr_handle( reply->parent );
-                }
-            }
-            SERVER_END_REQ;
+            if (style & WS_POPUP) retvalue = owner;
+            else if (style & WS_CHILD) retvalue = parent;
         }
     }
     else
@@ -2978,12 +3125,8 @@ HWND WINAPI GetAncestor( HWND hwnd, UINT type )
         }
         else /* need to query the server */
         {
-            SERVER_START_REQ( get_window_tree )
-            {
-                req->handle = wine_server_user_handle( hwnd );
-                if (!wine_server_call_err( req )) ret = wine_server_ptr_handle( reply->parent );
-            }
-            SERVER_END_REQ;
+            HWND owner;
+            get_window_tree_info( hwnd, &ret, &owner );
         }
         break;
 
@@ -883,11 +883,118 @@ static HRESULT init_script_cache(const HDC hdc, SCRIPT_CACHE *psc)
         heap_free(sc);
         return E_INVALIDARG;
     }
+    list_init(&sc->shape_cache);
     *psc = sc;
     TRACE("<- %p\n", sc);
     return S_OK;
 }
 
+/* Shaping results of the most recently shaped runs, most recent first. */
+#define SHAPE_CACHE_SIZE        32
+#define SHAPE_CACHE_MAX_CHARS   256
+
+struct shape_cache_entry
+{
+    struct list entry;
+    SCRIPT_ANALYSIS sa;
+    OPENTYPE_TAG script_tag;
+    OPENTYPE_TAG lang_tag;
+    int max_glyphs;
+    int char_count;
+    int glyph_count;
+    int glyph_prop_count;
+    SCRIPT_GLYPHPROP *glyph_props;
+    SCRIPT_CHARPROP *char_props;
+    WCHAR *chars;
+    WORD *log_clust;
+    WORD *glyphs;
+};
+
+static BOOL get_cached_shape(ScriptCache *sc, const SCRIPT_ANALYSIS *psa, const WCHAR *chars,
+                             int char_count, int max_glyphs, WORD *log_clust, SCRIPT_CHARPROP *char_props,
+                             WORD *glyphs, SCRIPT_GLYPHPROP *glyph_props, int *glyph_count)
+{
+    struct shape_cache_entry *entry;
+
+    LIST_FOR_EACH_ENTRY(entry, &sc->shape_cache, struct shape_cache_entry, entry)
+    {
+        if (entry->char_count != char_count || entry->max_glyphs != max_glyphs) continue;
+        if (entry->script_tag != sc->userScript || entry->lang_tag != sc->userLang) continue;
+        if (memcmp(&entry->sa, psa, sizeof(*psa))) continue;
+        if (memcmp(entry->chars, chars, char_count * sizeof(WCHAR))) continue;
+
+        memcpy(log_clust, entry->log_clust, char_count * sizeof(*log_clust));
+        memcpy(char_props, entry->char_props, char_count * sizeof(*char_props));
+        memcpy(glyphs, entry->glyphs, entry->glyph_count * sizeof(*glyphs));
+        memcpy(glyph_props, entry->glyph_props, entry->glyph_prop_count * sizeof(*glyph_props));
+        *glyph_count = entry->glyph_count;
+
+        list_remove(&entry->entry);
+        list_add_head(&sc->shape_cache, &entry->entry);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static void add_cached_shape(ScriptCache *sc, const SCRIPT_ANALYSIS *psa, const WCHAR *chars,
+                             int char_count, int max_glyphs, const WORD *log_clust,
+                             const SCRIPT_CHARPROP *char_props, const WORD *glyphs,
+                             const SCRIPT_GLYPHPROP *glyph_props, int glyph_count)
+{
+    struct shape_cache_entry *entry;
+    int glyph_prop_count = max(char_count, glyph_count);
+
+    if (char_count > SHAPE_CACHE_MAX_CHARS) return;
+
+    if (sc->shape_cache_count == SHAPE_CACHE_SIZE)
+    {
+        entry = LIST_ENTRY(list_tail(&sc->shape_cache), struct shape_cache_entry, entry);
+        list_remove(&entry->entry);
+        heap_free(entry);
+        sc->shape_cache_count--;
+    }
+
+    /* the arrays are stored after the entry, in decreasing order of alignment */
+    if (!(entry = heap_alloc(sizeof(*entry) + glyph_prop_count * sizeof(*glyph_props)
+            + char_count * (sizeof(*char_props) + sizeof(*chars) + sizeof(*log_clust))
+            + glyph_count * sizeof(*glyphs))))
+        return;
+
+    entry->sa = *psa;
+    entry->script_tag = sc->userScript;
+    entry->lang_tag = sc->userLang;
+    entry->max_glyphs = max_glyphs;
+    entry->char_count = char_count;
+    entry->glyph_count = glyph_count;
+    entry->glyph_prop_count = glyph_prop_count;
+    entry->glyph_props = (SCRIPT_GLYPHPROP *)(entry + 1);
+    entry->char_props = (SCRIPT_CHARPROP *)(entry->glyph_props + glyph_prop_count);
+    entry->chars = (WCHAR *)(entry->char_props + char_count);
+    entry->log_clust = entry->chars + char_count;
+    entry->glyphs = entry->log_clust + char_count;
+
+    memcpy(entry->glyph_props, glyph_props, glyph_prop_count * sizeof(*glyph_props));
+    memcpy(entry->char_props, char_props, char_count * sizeof(*char_props));
+    memcpy(entry->chars, chars, char_count * sizeof(*chars));
+    memcpy(entry->log_clust, log_clust, char_count * sizeof(*log_clust));
+    memcpy(entry->glyphs, glyphs, glyph_count * sizeof(*glyphs));
+
+    list_add_head(&sc->shape_cache, &entry->entry);
+    sc->shape_cache_count++;
+}
+
+static void free_shape_cache(ScriptCache *sc)
+{
+    struct shape_cache_entry *entry, *next;
+
+    LIST_FOR_EACH_ENTRY_SAFE(entry, next, &sc->shape_cache, struct shape_cache_entry, entry)
+    {
+        list_remove(&entry->entry);
+        heap_free(entry);
+    }
+    sc->shape_cache_count = 0;
+}
+
 static WCHAR mirror_char( WCHAR ch )
 {
     extern const WCHAR wine_mirror_map[] DECLSPEC_HIDDEN;
@@ -1069,6 +1176,7 @@ HRESULT WINAPI ScriptFreeCache(SCRIPT_CACHE *psc)
         }
         heap_free(((ScriptCache *)*psc)->scripts);
         heap_free(((ScriptCache *)*psc)->otm);
+        free_shape_cache((ScriptCache *)*psc);
         heap_free(*psc);
         *psc = NULL;
     }
@@ -3131,6 +3239,11 @@ HRESULT WINAPI ScriptShapeOpenType( HDC hdc, SCRIPT_CACHE *psc,
     if (psa && !psa->fNoGlyphIndex && ((ScriptCache *)*psc)->sfnt)
     {
         WCHAR *rChars;
+
+        if (!cRanges && get_cached_shape((ScriptCache *)*psc, psa, pwcChars, cChars, cMaxGlyphs,
+                pwLogClust, pCharProps, pwOutGlyphs, pOutGlyphProps, pcGlyphs))
+            return S_OK;
+
         if ((hr = SHAPE_CheckFontForRequiredFeatures(hdc, (ScriptCache *)*psc, psa)) != S_OK) return hr;
 
         rChars = heap_alloc(sizeof(WCHAR) * cChars);
@@ -3203,6 +3316,10 @@ HRESULT WINAPI ScriptShapeOpenType( HDC hdc, SCRIPT_CACHE *psc,
                 pOutGlyphProps[pwLogClust[i]].sva.fZeroWidth = 1;
             }
         }
+
+        if (!cRanges)
+            add_cached_shape((ScriptCache *)*psc, psa, pwcChars, cChars, cMaxGlyphs,
+                    pwLogClust, pCharProps, pwOutGlyphs, pOutGlyphProps, *pcGlyphs);
         heap_free(rChars);
     }
     else
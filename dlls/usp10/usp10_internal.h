@@ -18,6 +18,8 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
  *
  */
+#include "wine/list.h"
+
 #define MS_MAKE_TAG( _x1, _x2, _x3, _x4 ) \
           ( ( (ULONG)_x4 << 24 ) |     \
             ( (ULONG)_x3 << 16 ) |     \
@@ -193,6 +195,9 @@ typedef struct {
 
     OPENTYPE_TAG userScript;
     OPENTYPE_TAG userLang;
+
+    struct list shape_cache;
+    unsigned int shape_cache_count;
 } ScriptCache;
 
 typedef struct _scriptData
@@ -21,6 +21,7 @@
 #include "wined3d_private.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3d);
+WINE_DECLARE_DEBUG_CHANNEL(d3d_perf);
 
 #define WINED3D_INITIAL_CS_SIZE 4096
 
@@ -506,6 +507,12 @@ void wined3d_cs_emit_present(struct wined3d_cs *cs, struct wined3d_swapchain *sw
 
     cs->ops->submit(cs, WINED3D_CS_QUEUE_DEFAULT);
 
+    if (TRACE_ON(d3d_perf))
+        TRACE_(d3d_perf)("Frame submitted %u packets, filtered %u redundant state changes.\n",
+                cs->packet_count, cs->redundant_state_count);
+    cs->packet_count = 0;
+    cs->redundant_state_count = 0;
+
     /* Limit input latency by limiting the number of presents that we can get
      * ahead of the worker thread. We have a constant limit here, but
      * IDXGIDevice1 allows tuning this. */
@@ -2750,6 +2757,10 @@ static void wined3d_cs_st_submit(struct wined3d_cs *cs, enum wined3d_cs_queue_id
     data = cs->data;
     start = cs->start;
     cs->start = cs->end;
+    /* The statistics belong to the application thread, don't count packets
+     * emitted by the CS thread itself. */
+    if (cs->thread_id != GetCurrentThreadId())
+        ++cs->packet_count;
 
     opcode = *(const enum wined3d_cs_op *)&data[start];
     if (opcode >= WINED3D_CS_OP_STOP)
@@ -2802,6 +2813,7 @@ static void wined3d_cs_mt_submit(struct wined3d_cs *cs, enum wined3d_cs_queue_id
     if (cs->thread_id == GetCurrentThreadId())
         return wined3d_cs_st_submit(cs, queue_id);
 
+    ++cs->packet_count;
     wined3d_cs_queue_submit(&cs->queue[queue_id], cs);
 }
 
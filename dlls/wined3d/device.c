@@ -1428,6 +1428,8 @@ HRESULT CDECL wined3d_device_set_stream_source(struct wined3d_device *device, UI
             && stream->offset == offset)
     {
        TRACE("Application is setting the old values over, nothing to do.\n");
+       if (!device->recording)
+           ++device->cs->redundant_state_count;
        return WINED3D_OK;
     }
 
@@ -1552,6 +1554,7 @@ void CDECL wined3d_device_set_transform(struct wined3d_device *device,
     if (!memcmp(&device->state.transforms[d3dts], matrix, sizeof(*matrix)))
     {
         TRACE("The application is setting the same matrix over again.\n");
+        ++device->cs->redundant_state_count;
         return;
     }
 
@@ -1875,12 +1878,22 @@ void CDECL wined3d_device_set_material(struct wined3d_device *device, const stru
 {
     TRACE("device %p, material %p.\n", device, material);
 
-    device->update_state->material = *material;
-
     if (device->recording)
+    {
         device->recording->changed.material = TRUE;
-    else
-        wined3d_cs_emit_set_material(device->cs, material);
+        device->update_state->material = *material;
+        return;
+    }
+
+    if (!memcmp(&device->state.material, material, sizeof(*material)))
+    {
+        TRACE("Application is setting the old material over, nothing to do.\n");
+        ++device->cs->redundant_state_count;
+        return;
+    }
+
+    device->state.material = *material;
+    wined3d_cs_emit_set_material(device->cs, material);
 }
 
 void CDECL wined3d_device_get_material(const struct wined3d_device *device, struct wined3d_material *material)
@@ -1959,16 +1972,23 @@ void CDECL wined3d_device_set_viewport(struct wined3d_device *device, const stru
     TRACE("x %.8e, y %.8e, w %.8e, h %.8e, min_z %.8e, max_z %.8e.\n",
           viewport->x, viewport->y, viewport->width, viewport->height, viewport->min_z, viewport->max_z);
 
-    device->update_state->viewport = *viewport;
-
     /* Handle recording of state blocks */
     if (device->recording)
     {
         TRACE("Recording... not performing anything\n");
         device->recording->changed.viewport = TRUE;
+        device->update_state->viewport = *viewport;
+        return;
+    }
+
+    if (!memcmp(&device->state.viewport, viewport, sizeof(*viewport)))
+    {
+        TRACE("Application is setting the old viewport over, nothing to do.\n");
+        ++device->cs->redundant_state_count;
         return;
     }
 
+    device->state.viewport = *viewport;
     wined3d_cs_emit_set_viewport(device->cs, viewport);
 }
 
@@ -2055,9 +2075,14 @@ void CDECL wined3d_device_set_render_state(struct wined3d_device *device,
 
     /* Compared here and not before the assignment to allow proper stateblock recording. */
     if (value == old_value)
+    {
         TRACE("Application is setting the old value over, nothing to do.\n");
+        ++device->cs->redundant_state_count;
+    }
     else
+    {
         wined3d_cs_emit_set_render_state(device->cs, state, value);
+    }
 
     if (state == WINED3D_RS_POINTSIZE && value == WINED3D_RESZ_CODE)
     {
@@ -2104,6 +2129,7 @@ void CDECL wined3d_device_set_sampler_state(struct wined3d_device *device,
     if (old_value == value)
     {
         TRACE("Application is setting the old value over, nothing to do.\n");
+        ++device->cs->redundant_state_count;
         return;
     }
 
@@ -3443,6 +3469,7 @@ void CDECL wined3d_device_set_texture_stage_state(struct wined3d_device *device,
     if (old_value == value)
     {
         TRACE("Application is setting the old value over, nothing to do.\n");
+        ++device->cs->redundant_state_count;
         return;
     }
 
@@ -3496,6 +3523,8 @@ HRESULT CDECL wined3d_device_set_texture(struct wined3d_device *device,
     if (texture == prev)
     {
         TRACE("App is setting the same texture again, nothing to do.\n");
+        if (!device->recording)
+            ++device->cs->redundant_state_count;
         return WINED3D_OK;
     }
 
@@ -3523,6 +3523,10 @@ struct wined3d_cs
     HANDLE event;
     BOOL waiting_for_event;
     LONG pending_presents;
+
+    /* Per-frame statistics, reported on the d3d_perf channel. */
+    unsigned int packet_count;
+    unsigned int redundant_state_count;
 };
 
 struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device) DECLSPEC_HIDDEN;
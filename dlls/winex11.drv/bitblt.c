@@ -1557,13 +1557,27 @@ DWORD get_pixmap_image( Pixmap pixmap, int width, int height, const XVisualInfo
 }
 
 
+/* surfaces track updates in square tiles of 1 << SURFACE_TILE_SHIFT pixels */
+#define SURFACE_TILE_SHIFT      6
+#define SURFACE_TILE_SIZE       (1 << SURFACE_TILE_SHIFT)
+#define SURFACE_MAX_FLUSH_RECTS 64
+#define SURFACE_FLUSH_PERIOD    50  /* time in ms since drawing started for forcing a flush */
+
 struct x11drv_window_surface
 {
     struct window_surface header;
     Window                window;
     GC                    gc;
     XImage               *image;
-    RECT                  bounds;
+    RECT                  bounds;       /* accumulated by the dib driver */
+    RECT                  dirty_bounds; /* bounds of the dirty tiles */
+    BYTE                 *dirty;        /* one entry per tile */
+    int                   tiles_x;
+    int                   tiles_y;
+    int                   lock_depth;   /* recursion count of the surface lock */
+    DWORD                 dirty_ticks;  /* time when the first dirty tile was set */
+    DWORD                 stats_ticks;
+    ULONGLONG             stats_bytes;
     BOOL                  byteswap;
     BOOL                  is_argb;
     COLORREF              color_key;
@@ -1581,6 +1595,74 @@ static struct x11drv_window_surface *get_x11_surface( struct window_surface *sur
     return (struct x11drv_window_surface *)surface;
 }
 
+/* move the bounds accumulated since the last call to the dirty tiles */
+static void update_dirty_tiles( struct x11drv_window_surface *surface )
+{
+    RECT rect;
+    int y, left, right;
+
+    SetRect( &rect, 0, 0, surface->header.rect.right - surface->header.rect.left,
+             surface->header.rect.bottom - surface->header.rect.top );
+    if (IntersectRect( &rect, &rect, &surface->bounds ))
+    {
+        if (IsRectEmpty( &surface->dirty_bounds )) surface->dirty_ticks = GetTickCount();
+        add_bounds_rect( &surface->dirty_bounds, &rect );
+
+        left = rect.left >> SURFACE_TILE_SHIFT;
+        right = (rect.right - 1) >> SURFACE_TILE_SHIFT;
+        for (y = rect.top >> SURFACE_TILE_SHIFT; y <= (rect.bottom - 1) >> SURFACE_TILE_SHIFT; y++)
+            memset( surface->dirty + y * surface->tiles_x + left, 1, right - left + 1 );
+    }
+    reset_bounds( &surface->bounds );
+}
+
+/* build a list of rectangles covering the dirty tiles, tiles spans of the same
+ * width in consecutive rows are merged; returns 0 if there are too many */
+static int get_dirty_rects( struct x11drv_window_surface *surface, RECT *rects, int max_rects )
+{
+    int x, y, i, start, count = 0;
+    int top = surface->dirty_bounds.top >> SURFACE_TILE_SHIFT;
+    int bottom = (surface->dirty_bounds.bottom - 1) >> SURFACE_TILE_SHIFT;
+    int left = surface->dirty_bounds.left >> SURFACE_TILE_SHIFT;
+    int right = (surface->dirty_bounds.right - 1) >> SURFACE_TILE_SHIFT;
+
+    for (y = top; y <= bottom; y++)
+    {
+        BYTE *row = surface->dirty + y * surface->tiles_x;
+
+        for (x = left; x <= right; x++)
+        {
+            if (!row[x]) continue;
+            for (start = x; x <= right && row[x]; x++) ;
+
+            for (i = 0; i < count; i++)
+                if (rects[i].bottom == y << SURFACE_TILE_SHIFT &&
+                    rects[i].left == start << SURFACE_TILE_SHIFT &&
+                    rects[i].right == x << SURFACE_TILE_SHIFT) break;
+
+            if (i < count) rects[i].bottom += SURFACE_TILE_SIZE;
+            else
+            {
+                if (count == max_rects) return 0;
+                SetRect( &rects[count++], start << SURFACE_TILE_SHIFT, y << SURFACE_TILE_SHIFT,
+                         x << SURFACE_TILE_SHIFT, (y + 1) << SURFACE_TILE_SHIFT );
+            }
+        }
+    }
+    return count;
+}
+
+static void reset_dirty_tiles( struct x11drv_window_surface *surface )
+{
+    int y;
+
+    if (IsRectEmpty( &surface->dirty_bounds )) return;
+    for (y = surface->dirty_bounds.top >> SURFACE_TILE_SHIFT;
+         y <= (surface->dirty_bounds.bottom - 1) >> SURFACE_TILE_SHIFT; y++)
+        memset( surface->dirty + y * surface->tiles_x, 0, surface->tiles_x );
+    reset_bounds( &surface->dirty_bounds );
+}
+
 static inline UINT get_color_component( UINT color, UINT mask )
 {
     int shift;
@@ -1863,6 +1945,7 @@ static void x11drv_surface_lock( struct window_surface *window_surface )
     struct x11drv_window_surface *surface = get_x11_surface( window_surface );
 
     EnterCriticalSection( &surface->crit );
+    surface->lock_depth++;
 }
 
 /***********************************************************************
@@ -1871,8 +1954,15 @@ static void x11drv_surface_lock( struct window_surface *window_surface )
 static void x11drv_surface_unlock( struct window_surface *window_surface )
 {
     struct x11drv_window_surface *surface = get_x11_surface( window_surface );
+    BOOL flush = FALSE;
 
+    update_dirty_tiles( surface );
+    /* the bounds are reset on every unlock, so the dib driver can't time the drawing itself */
+    if (!--surface->lock_depth)
+        flush = !IsRectEmpty( &surface->dirty_bounds ) &&
+                GetTickCount() - surface->dirty_ticks > SURFACE_FLUSH_PERIOD;
     LeaveCriticalSection( &surface->crit );
+    if (flush) window_surface->funcs->flush( window_surface );
 }
 
 /***********************************************************************
@@ -1927,6 +2017,31 @@ static void x11drv_surface_set_region( struct window_surface *window_surface, HR
     window_surface->funcs->unlock( window_surface );
 }
 
+/***********************************************************************
+ *           put_surface_image
+ */
+static void put_surface_image( struct x11drv_window_surface *surface, const RECT *rect )
+{
+#ifdef HAVE_LIBXXSHM
+    if (surface->shminfo.shmid != -1)
+        XShmPutImage( gdi_display, surface->window, surface->gc, surface->image,
+                      rect->left, rect->top,
+                      surface->header.rect.left + rect->left,
+                      surface->header.rect.top + rect->top,
+                      rect->right - rect->left, rect->bottom - rect->top, False );
+    else
+#endif
+    XPutImage( gdi_display, surface->window, surface->gc, surface->image,
+               rect->left, rect->top,
+               surface->header.rect.left + rect->left,
+               surface->header.rect.top + rect->top,
+               rect->right - rect->left, rect->bottom - rect->top );
+
+    if (TRACE_ON(bitblt))
+        surface->stats_bytes += (ULONGLONG)(rect->right - rect->left) * (rect->bottom - rect->top) *
+                                surface->image->bits_per_pixel / 8;
+}
+
 /***********************************************************************
  *           x11drv_surface_flush
  */
@@ -1935,19 +2050,22 @@ static void x11drv_surface_flush( struct window_surface *window_surface )
     struct x11drv_window_surface *surface = get_x11_surface( window_surface );
     unsigned char *src = surface->bits;
     unsigned char *dst = (unsigned char *)surface->image->data;
+    RECT rects[SURFACE_MAX_FLUSH_RECTS];
     struct bitblt_coords coords;
+    int i, count;
 
     window_surface->funcs->lock( window_surface );
+    update_dirty_tiles( surface );
     coords.x = 0;
     coords.y = 0;
     coords.width  = surface->header.rect.right - surface->header.rect.left;
     coords.height = surface->header.rect.bottom - surface->header.rect.top;
     SetRect( &coords.visrect, 0, 0, coords.width, coords.height );
-    if (IntersectRect( &coords.visrect, &coords.visrect, &surface->bounds ))
+    if (IntersectRect( &coords.visrect, &coords.visrect, &surface->dirty_bounds ))
     {
         TRACE( "flushing %p %dx%d bounds %s bits %p\n",
                surface, coords.width, coords.height,
-               wine_dbgstr_rect( &surface->bounds ), surface->bits );
+               wine_dbgstr_rect( &surface->dirty_bounds ), surface->bits );
 
         if (surface->is_argb || surface->color_key != CLR_INVALID) update_surface_region( surface );
 
@@ -1966,25 +2084,29 @@ static void x11drv_surface_flush( struct window_surface *window_surface )
                                  surface->byteswap, mapping, ~0u );
         }
 
-#ifdef HAVE_LIBXXSHM
-        if (surface->shminfo.shmid != -1)
-            XShmPutImage( gdi_display, surface->window, surface->gc, surface->image,
-                          coords.visrect.left, coords.visrect.top,
-                          surface->header.rect.left + coords.visrect.left,
-                          surface->header.rect.top + coords.visrect.top,
-                          coords.visrect.right - coords.visrect.left,
-                          coords.visrect.bottom - coords.visrect.top, False );
-        else
-#endif
-        XPutImage( gdi_display, surface->window, surface->gc, surface->image,
-                   coords.visrect.left, coords.visrect.top,
-                   surface->header.rect.left + coords.visrect.left,
-                   surface->header.rect.top + coords.visrect.top,
-                   coords.visrect.right - coords.visrect.left,
-                   coords.visrect.bottom - coords.visrect.top );
+        if ((count = get_dirty_rects( surface, rects, SURFACE_MAX_FLUSH_RECTS )))
+        {
+            for (i = 0; i < count; i++)
+                if (IntersectRect( &rects[i], &rects[i], &coords.visrect ))
+                    put_surface_image( surface, &rects[i] );
+        }
+        else put_surface_image( surface, &coords.visrect );
         XFlush( gdi_display );
+
+        if (TRACE_ON(bitblt))
+        {
+            DWORD ticks = GetTickCount();
+
+            if (ticks - surface->stats_ticks >= 1000)
+            {
+                TRACE( "%p pushed %s bytes/s\n", surface,
+                       wine_dbgstr_longlong( surface->stats_bytes * 1000 / (ticks - surface->stats_ticks) ));
+                surface->stats_ticks = ticks;
+                surface->stats_bytes = 0;
+            }
+        }
     }
-    reset_bounds( &surface->bounds );
+    reset_dirty_tiles( surface );
     window_surface->funcs->unlock( window_surface );
 }
 
@@ -2015,6 +2137,7 @@ static void x11drv_surface_destroy( struct window_surface *window_surface )
     surface->crit.DebugInfo->Spare[0] = 0;
     DeleteCriticalSection( &surface->crit );
     if (surface->region) DeleteObject( surface->region );
+    HeapFree( GetProcessHeap(), 0, surface->dirty );
     HeapFree( GetProcessHeap(), 0, surface );
 }
 
@@ -2061,6 +2184,13 @@ struct window_surface *create_surface( Window window, const XVisualInfo *vis, co
     surface->is_argb = (use_alpha && vis->depth == 32 && surface->info.bmiHeader.biCompression == BI_RGB);
     set_color_key( surface, color_key );
     reset_bounds( &surface->bounds );
+    reset_bounds( &surface->dirty_bounds );
+
+    surface->tiles_x = (width + SURFACE_TILE_SIZE - 1) >> SURFACE_TILE_SHIFT;
+    surface->tiles_y = (height + SURFACE_TILE_SIZE - 1) >> SURFACE_TILE_SHIFT;
+    if (!(surface->dirty = HeapAlloc( GetProcessHeap(), HEAP_ZERO_MEMORY,
+                                      max( 1, surface->tiles_x * surface->tiles_y ))))
+        goto failed;
 
 #ifdef HAVE_LIBXXSHM
     surface->image = create_shm_image( vis, width, height, &surface->shminfo );
@@ -268,7 +268,8 @@ enum event_merge_action
     MERGE_DISCARD,  /* discard the old event */
     MERGE_HANDLE,   /* handle the old event */
     MERGE_KEEP,     /* keep the old event for future merging */
-    MERGE_IGNORE    /* ignore the new event, keep the old one */
+    MERGE_IGNORE,   /* ignore the new event, keep the old one */
+    MERGE_DEFER     /* keep the old event, set the new one aside for merging */
 };
 
 /***********************************************************************
@@ -350,7 +351,7 @@ static enum event_merge_action merge_events( XEvent *prev, XEvent *next )
             if (next->xcookie.extension != xinput2_opcode) break;
             if (next->xcookie.evtype != XI_RawMotion) break;
             if (x11drv_thread_data()->warp_serial) break;
-            return MERGE_KEEP;
+            return MERGE_DEFER;
         }
         break;
     case GenericEvent:
@@ -402,17 +403,62 @@ static inline BOOL call_event_handler( Display *display, XEvent *event )
 }
 
 
+/***********************************************************************
+ *           merge_deferred_event
+ *
+ * Merge an event with the one that was set aside, handling the latter if they can't be merged.
+ */
+static BOOL merge_deferred_event( Display *display, XEvent *deferred, XEvent *event )
+{
+    BOOL queued = FALSE;
+
+    if (deferred->type)
+    {
+        switch (merge_events( deferred, event ))
+        {
+        case MERGE_IGNORE:  /* merged into the deferred event */
+            free_event_data( event );
+            return FALSE;
+        case MERGE_HANDLE:
+            queued = call_event_handler( display, deferred );
+            break;
+        default:
+            break;
+        }
+        free_event_data( deferred );
+    }
+    *deferred = *event;
+    return queued;
+}
+
+
+/***********************************************************************
+ *           flush_deferred_event
+ */
+static BOOL flush_deferred_event( Display *display, XEvent *deferred )
+{
+    BOOL queued;
+
+    if (!deferred->type) return FALSE;
+    queued = call_event_handler( display, deferred );
+    free_event_data( deferred );
+    deferred->type = 0;
+    return queued;
+}
+
+
 /***********************************************************************
  *           process_events
  */
 static BOOL process_events( Display *display, Bool (*filter)(Display*, XEvent*,XPointer), ULONG_PTR arg )
 {
-    XEvent event, prev_event;
+    XEvent event, prev_event, deferred_event;
     int count = 0;
     BOOL queued = FALSE;
     enum event_merge_action action = MERGE_DISCARD;
 
     prev_event.type = 0;
+    deferred_event.type = 0;
     while (XCheckIfEvent( display, &event, filter, (char *)arg ))
     {
         count++;
@@ -451,6 +497,7 @@ static BOOL process_events( Display *display, Bool (*filter)(Display*, XEvent*,X
         switch( action )
         {
         case MERGE_HANDLE:  /* handle prev, keep new */
+            queued |= flush_deferred_event( display, &deferred_event );
             queued |= call_event_handler( display, &prev_event );
             /* fall through */
         case MERGE_DISCARD:  /* discard prev, keep new */
@@ -458,13 +505,18 @@ static BOOL process_events( Display *display, Bool (*filter)(Display*, XEvent*,X
             prev_event = event;
             break;
         case MERGE_KEEP:  /* handle new, keep prev for future merging */
+            queued |= flush_deferred_event( display, &deferred_event );
             queued |= call_event_handler( display, &event );
             /* fall through */
         case MERGE_IGNORE: /* ignore new, keep prev for future merging */
             free_event_data( &event );
             break;
+        case MERGE_DEFER:  /* keep prev, merge new with the deferred event */
+            queued |= merge_deferred_event( display, &deferred_event, &event );
+            break;
         }
     }
+    queued |= flush_deferred_event( display, &deferred_event );
     if (prev_event.type) queued |= call_event_handler( display, &prev_event );
     free_event_data( &prev_event );
     XFlush( gdi_display );
@@ -58,6 +58,7 @@ typedef struct
 {
     unsigned int last_input_time;
     unsigned int foreground_wnd_epoch;
+    unsigned int window_info_epoch;
 } shmglobal_t;
 
 
@@ -6797,6 +6798,6 @@ union generic_reply
     struct resume_process_reply resume_process_reply;
 };
 
-#define SERVER_PROTOCOL_VERSION 544
+#define SERVER_PROTOCOL_VERSION 545
 
 #endif /* __WINE_WINE_SERVER_PROTOCOL_H */
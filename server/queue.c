@@ -384,31 +384,55 @@ static int assign_thread_input( struct thread *thread, struct thread_input *new_
     return 1;
 }
 
-/* set the cursor position and queue the corresponding mouse message */
-static void set_cursor_pos( struct desktop *desktop, int x, int y )
+/* freed hardware messages, kept around to avoid allocations for every input event */
+#define MAX_FREE_HARDWARE_MESSAGES 64
+static struct list free_hardware_messages = LIST_INIT( free_hardware_messages );
+static unsigned int free_hardware_count;
+
+/* allocate a hardware message and its data */
+static struct message *alloc_hardware_message( lparam_t info, unsigned int time )
 {
     struct hardware_msg_data *msg_data;
     struct message *msg;
+    struct list *ptr;
 
-    if (!(msg = mem_alloc( sizeof(*msg) ))) return;
-    if (!(msg_data = mem_alloc( sizeof(*msg_data) )))
+    if ((ptr = list_head( &free_hardware_messages )))
     {
-        free( msg );
-        return;
+        list_remove( ptr );
+        free_hardware_count--;
+        msg = LIST_ENTRY( ptr, struct message, entry );
+        msg_data = msg->data;
     }
+    else
+    {
+        if (!(msg = mem_alloc( sizeof(*msg) ))) return NULL;
+        if (!(msg_data = mem_alloc( sizeof(*msg_data) )))
+        {
+            free( msg );
+            return NULL;
+        }
+    }
+    memset( msg, 0, sizeof(*msg) );
     memset( msg_data, 0, sizeof(*msg_data) );
 
     msg->type      = MSG_HARDWARE;
-    msg->win       = 0;
+    msg->time      = time;
+    msg->data      = msg_data;
+    msg->data_size = sizeof(*msg_data);
+    msg_data->info = info;
+    return msg;
+}
+
+/* set the cursor position and queue the corresponding mouse message */
+static void set_cursor_pos( struct desktop *desktop, int x, int y )
+{
+    struct message *msg;
+
+    if (!(msg = alloc_hardware_message( 0, get_tick_count() ))) return;
+
     msg->msg       = WM_MOUSEMOVE;
-    msg->wparam    = 0;
-    msg->lparam    = 0;
     msg->x         = x;
     msg->y         = y;
-    msg->time      = get_tick_count();
-    msg->result    = NULL;
-    msg->data      = msg_data;
-    msg->data_size = sizeof(*msg_data);
     queue_hardware_message( desktop, msg, 1 );
 }
 
@@ -676,6 +700,13 @@ static void free_message( struct message *msg )
         result->receiver = NULL;
         store_message_result( result, 0, STATUS_ACCESS_DENIED /*FIXME*/ );
     }
+    if (msg->type == MSG_HARDWARE && msg->data && msg->data_size == sizeof(struct hardware_msg_data) &&
+        free_hardware_count < MAX_FREE_HARDWARE_MESSAGES)
+    {
+        list_add_head( &free_hardware_messages, &msg->entry );
+        free_hardware_count++;
+        return;
+    }
     free( msg->data );
     free( msg );
 }
@@ -1764,24 +1795,13 @@ static int queue_mouse_message( struct desktop *desktop, user_handle_t win, cons
 
     if ((device = current->process->rawinput_mouse))
     {
-        if (!(msg = mem_alloc( sizeof(*msg) ))) return 0;
-        if (!(msg_data = mem_alloc( sizeof(*msg_data) )))
-        {
-            free( msg );
-            return 0;
-        }
+        if (!(msg = alloc_hardware_message( input->mouse.info, time ))) return 0;
+        msg_data = msg->data;
 
-        msg->type      = MSG_HARDWARE;
         msg->win       = device->target;
         msg->msg       = WM_INPUT;
         msg->wparam    = RIM_INPUT;
-        msg->lparam    = 0;
-        msg->time      = time;
-        msg->data      = msg_data;
-        msg->data_size = sizeof(*msg_data);
-        msg->result    = NULL;
 
-        msg_data->info                = input->mouse.info;
         msg_data->flags               = flags;
         msg_data->rawinput.type       = RIM_TYPEMOUSE;
         msg_data->rawinput.mouse.x    = x - desktop->cursor.x;
@@ -1797,26 +1817,14 @@ static int queue_mouse_message( struct desktop *desktop, user_handle_t win, cons
         if (!(flags & (1 << i))) continue;
         flags &= ~(1 << i);
 
-        if (!(msg = mem_alloc( sizeof(*msg) ))) return 0;
-        if (!(msg_data = mem_alloc( sizeof(*msg_data) )))
-        {
-            free( msg );
-            return 0;
-        }
-        memset( msg_data, 0, sizeof(*msg_data) );
+        if (!(msg = alloc_hardware_message( input->mouse.info, time ))) return 0;
+        msg_data = msg->data;
 
-        msg->type      = MSG_HARDWARE;
         msg->win       = get_user_full_handle( win );
         msg->msg       = messages[i];
         msg->wparam    = input->mouse.data << 16;
-        msg->lparam    = 0;
         msg->x         = x;
         msg->y         = y;
-        msg->time      = time;
-        msg->result    = NULL;
-        msg->data      = msg_data;
-        msg->data_size = sizeof(*msg_data);
-        msg_data->info = input->mouse.info;
         if (hook_flags & SEND_HWMSG_INJECTED) msg_data->flags = LLMHF_INJECTED;
 
         /* specify a sender only when sending the last message */
@@ -1910,24 +1918,13 @@ static int queue_keyboard_message( struct desktop *desktop, user_handle_t win, c
 
     if ((device = current->process->rawinput_kbd))
     {
-        if (!(msg = mem_alloc( sizeof(*msg) ))) return 0;
-        if (!(msg_data = mem_alloc( sizeof(*msg_data) )))
-        {
-            free( msg );
-            return 0;
-        }
+        if (!(msg = alloc_hardware_message( input->kbd.info, time ))) return 0;
+        msg_data = msg->data;
 
-        msg->type      = MSG_HARDWARE;
         msg->win       = device->target;
         msg->msg       = WM_INPUT;
         msg->wparam    = RIM_INPUT;
-        msg->lparam    = 0;
-        msg->time      = time;
-        msg->data      = msg_data;
-        msg->data_size = sizeof(*msg_data);
-        msg->result    = NULL;
 
-        msg_data->info                 = input->kbd.info;
         msg_data->flags                = input->kbd.flags;
         msg_data->rawinput.type        = RIM_TYPEKEYBOARD;
         msg_data->rawinput.kbd.message = message_code;
@@ -1937,23 +1934,12 @@ static int queue_keyboard_message( struct desktop *desktop, user_handle_t win, c
         queue_hardware_message( desktop, msg, 0 );
     }
 
-    if (!(msg = mem_alloc( sizeof(*msg) ))) return 0;
-    if (!(msg_data = mem_alloc( sizeof(*msg_data) )))
-    {
-        free( msg );
-        return 0;
-    }
-    memset( msg_data, 0, sizeof(*msg_data) );
+    if (!(msg = alloc_hardware_message( input->kbd.info, time ))) return 0;
+    msg_data = msg->data;
 
-    msg->type      = MSG_HARDWARE;
     msg->win       = get_user_full_handle( win );
     msg->msg       = message_code;
     msg->lparam    = (input->kbd.scan << 16) | 1u; /* repeat count */
-    msg->time      = time;
-    msg->result    = NULL;
-    msg->data      = msg_data;
-    msg->data_size = sizeof(*msg_data);
-    msg_data->info = input->kbd.info;
     if (hook_flags & SEND_HWMSG_INJECTED) msg_data->flags = LLKHF_INJECTED;
 
     if (input->kbd.flags & KEYEVENTF_UNICODE)
@@ -1983,28 +1969,15 @@ static int queue_keyboard_message( struct desktop *desktop, user_handle_t win, c
 static void queue_custom_hardware_message( struct desktop *desktop, user_handle_t win,
                                            const hw_input_t *input )
 {
-    struct hardware_msg_data *msg_data;
     struct message *msg;
 
-    if (!(msg = mem_alloc( sizeof(*msg) ))) return;
-    if (!(msg_data = mem_alloc( sizeof(*msg_data) )))
-    {
-        free( msg );
-        return;
-    }
-    memset( msg_data, 0, sizeof(*msg_data) );
+    if (!(msg = alloc_hardware_message( 0, get_tick_count() ))) return;
 
-    msg->type      = MSG_HARDWARE;
     msg->win       = get_user_full_handle( win );
     msg->msg       = input->hw.msg;
-    msg->wparam    = 0;
     msg->lparam    = input->hw.lparam;
     msg->x         = desktop->cursor.x;
     msg->y         = desktop->cursor.y;
-    msg->time      = get_tick_count();
-    msg->result    = NULL;
-    msg->data      = msg_data;
-    msg->data_size = sizeof(*msg_data);
 
     queue_hardware_message( desktop, msg, 1 );
 }
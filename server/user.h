@@ -207,6 +207,12 @@ static inline int intersect_rect( rectangle_t *dst, const rectangle_t *src1, con
     return (dst->left < dst->right && dst->top < dst->bottom);
 }
 
+/* check if a rectangle is empty */
+static inline int is_rect_empty( const rectangle_t *rect )
+{
+    return (rect->left >= rect->right || rect->top >= rect->bottom);
+}
+
 /* validate a window handle and return the full handle */
 static inline user_handle_t get_valid_window_handle( user_handle_t win )
 {
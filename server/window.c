@@ -33,6 +33,7 @@
 #include "winternl.h"
 
 #include "object.h"
+#include "file.h"
 #include "request.h"
 #include "thread.h"
 #include "process.h"
@@ -74,6 +75,11 @@ struct window
     struct region   *win_region;      /* region for shaped windows (relative to window rect) */
     struct region   *layer_region;    /* region for layered windows (relative to window rect) */
     struct region   *update_region;   /* update region (relative to window rect) */
+    struct region   *vis_cache;       /* cached visible region (relative to window) */
+    unsigned int     vis_cache_flags; /* DCX flags used to compute the cached region */
+    unsigned int     vis_cache_gen;   /* clip generation of the cached region */
+    unsigned int     clip_gen;        /* clip generation of the window and its children */
+    struct point_index *point_index;  /* spatial index of the children for hit testing */
     unsigned int     style;           /* window style */
     unsigned int     ex_style;        /* window extended style */
     unsigned int     id;              /* window id */
@@ -119,6 +125,27 @@ static struct window *shell_listview;
 static struct window *progman_window;
 static struct window *taskman_window;
 
+/* incremented whenever something that affects visible regions changes */
+static unsigned int clip_generation;
+
+/* grid of the visible children of a window, to find the ones containing a point */
+#define POINT_INDEX_GRID         16   /* number of cells in each direction */
+#define POINT_INDEX_MIN_CHILDREN 64   /* don't index windows with fewer visible children */
+#define POINT_INDEX_MIN_LOOKUPS  4    /* number of hit tests before building the index */
+
+struct point_index
+{
+    unsigned int     clip_gen;        /* clip generation of the parent the index is valid for */
+    unsigned int     lookups;         /* number of hit tests at this generation */
+    int              valid;           /* is the grid up to date? */
+    rectangle_t      bounds;          /* bounding rectangle of the indexed children */
+    int              cell_width;      /* size of a grid cell */
+    int              cell_height;
+    unsigned int    *cells;           /* index of the first window of each cell */
+    struct window  **windows;         /* children in Z-order, grouped by cell */
+    unsigned int     size;            /* allocated size of the windows array */
+};
+
 /* magic HWND_TOP etc. pointers */
 #define WINPTR_TOP       ((struct window *)1L)
 #define WINPTR_BOTTOM    ((struct window *)2L)
@@ -167,6 +194,20 @@ static inline struct window *get_last_child( struct window *win )
     return ptr ? LIST_ENTRY( ptr, struct window, entry ) : NULL;
 }
 
+/* mark the window information cached by the clients as outdated */
+static inline void invalidate_window_info(void)
+{
+    if (shmglobal) interlocked_xchg_add( (int *)&shmglobal->window_info_epoch, 1 );
+}
+
+/* mark the visible regions of a window, its siblings, its parent and all their children as outdated */
+static inline void invalidate_visible_regions( struct window *win )
+{
+    win->clip_gen = ++clip_generation;
+    if (win->parent) win->parent->clip_gen = clip_generation;
+    invalidate_window_info();
+}
+
 /* set the PAINT_PIXEL_FORMAT_CHILD flag on all the parents */
 /* note: we never reset the flag, it's just a heuristic */
 static inline void update_pixel_format_flags( struct window *win )
@@ -185,6 +226,7 @@ static void link_window( struct window *win, struct window *previous )
         previous = WINPTR_TOP;  /* fallback to the HWND_TOP case */
     }
 
+    invalidate_visible_regions( win );
     list_remove( &win->entry );  /* unlink it from the previous location */
 
     if (previous == WINPTR_BOTTOM)
@@ -247,6 +289,7 @@ static int set_parent_window( struct window *win, struct window *parent )
 
     if (parent)
     {
+        if (win->parent) invalidate_visible_regions( win );  /* for the old parent */
         win->parent = parent;
         link_window( win, WINPTR_TOP );
 
@@ -260,6 +303,7 @@ static int set_parent_window( struct window *win, struct window *parent )
     }
     else  /* move it to parent unlinked list */
     {
+        invalidate_visible_regions( win );
         list_remove( &win->entry );  /* unlink it from the previous location */
         list_add_head( &win->parent->unlinked, &win->entry );
         win->is_linked = 0;
@@ -480,6 +524,11 @@ static struct window *create_window( struct window *parent, struct window *owner
     win->win_region     = NULL;
     win->layer_region   = NULL;
     win->update_region  = NULL;
+    win->vis_cache      = NULL;
+    win->vis_cache_flags = 0;
+    win->vis_cache_gen  = 0;
+    win->clip_gen       = 0;
+    win->point_index    = NULL;
     win->style          = 0;
     win->ex_style       = 0;
     win->id             = 0;
@@ -684,15 +733,187 @@ static unsigned int get_children_windows( struct window *parent, atom_t atom, th
     return count;
 }
 
-/* find child of 'parent' that contains the given point (in parent-relative coords) */
-static struct window *child_window_from_point( struct window *parent, int x, int y )
+/* get the range of grid cells covered by a rectangle */
+static inline void get_point_index_cells( const struct point_index *index, const rectangle_t *rect,
+                                          rectangle_t *cells )
+{
+    cells->left   = (rect->left - index->bounds.left) / index->cell_width;
+    cells->top    = (rect->top - index->bounds.top) / index->cell_height;
+    cells->right  = (rect->right - 1 - index->bounds.left) / index->cell_width + 1;
+    cells->bottom = (rect->bottom - 1 - index->bounds.top) / index->cell_height + 1;
+}
+
+/* build the grid of the visible children of a window */
+static int build_point_index( struct window *parent, struct point_index *index )
 {
+    unsigned int pos[POINT_INDEX_GRID * POINT_INDEX_GRID];
+    unsigned int i, count = 0;
     struct window *ptr;
+    rectangle_t cells;
+    int x, y;
+
+    LIST_FOR_EACH_ENTRY( ptr, &parent->children, struct window, entry )
+    {
+        if (!(ptr->style & WS_VISIBLE) || is_rect_empty( &ptr->visible_rect )) continue;
+        if (!count++) index->bounds = ptr->visible_rect;
+        else
+        {
+            index->bounds.left   = min( index->bounds.left, ptr->visible_rect.left );
+            index->bounds.top    = min( index->bounds.top, ptr->visible_rect.top );
+            index->bounds.right  = max( index->bounds.right, ptr->visible_rect.right );
+            index->bounds.bottom = max( index->bounds.bottom, ptr->visible_rect.bottom );
+        }
+    }
+    if (count < POINT_INDEX_MIN_CHILDREN) return 0;
+
+    if (!index->cells && !(index->cells = malloc( (POINT_INDEX_GRID * POINT_INDEX_GRID + 1) *
+                                                  sizeof(*index->cells) )))
+        return 0;
+    index->cell_width  = (index->bounds.right - index->bounds.left + POINT_INDEX_GRID - 1) / POINT_INDEX_GRID;
+    index->cell_height = (index->bounds.bottom - index->bounds.top + POINT_INDEX_GRID - 1) / POINT_INDEX_GRID;
+
+    /* count the windows in each cell */
+    memset( pos, 0, sizeof(pos) );
+    count = 0;
+    LIST_FOR_EACH_ENTRY( ptr, &parent->children, struct window, entry )
+    {
+        if (!(ptr->style & WS_VISIBLE) || is_rect_empty( &ptr->visible_rect )) continue;
+        get_point_index_cells( index, &ptr->visible_rect, &cells );
+        for (y = cells.top; y < cells.bottom; y++)
+            for (x = cells.left; x < cells.right; x++) pos[y * POINT_INDEX_GRID + x]++;
+        count += (cells.right - cells.left) * (cells.bottom - cells.top);
+    }
 
+    if (count > index->size)
+    {
+        struct window **windows = realloc( index->windows, count * sizeof(*windows) );
+        if (!windows) return 0;
+        index->windows = windows;
+        index->size = count;
+    }
+
+    for (i = count = 0; i < POINT_INDEX_GRID * POINT_INDEX_GRID; i++)
+    {
+        index->cells[i] = count;
+        count += pos[i];
+        pos[i] = index->cells[i];
+    }
+    index->cells[i] = count;
+
+    /* store them in Z-order */
     LIST_FOR_EACH_ENTRY( ptr, &parent->children, struct window, entry )
     {
-        if (!is_point_in_window( ptr, x, y )) continue;  /* skip it */
+        if (!(ptr->style & WS_VISIBLE) || is_rect_empty( &ptr->visible_rect )) continue;
+        get_point_index_cells( index, &ptr->visible_rect, &cells );
+        for (y = cells.top; y < cells.bottom; y++)
+            for (x = cells.left; x < cells.right; x++)
+                index->windows[pos[y * POINT_INDEX_GRID + x]++] = ptr;
+    }
+    return 1;
+}
+
+/* get the children of a window that may contain the given point, in Z-order */
+/* returns NULL if the children have to be enumerated instead */
+static struct window **get_children_at_point( struct window *parent, int x, int y, unsigned int *count )
+{
+    struct point_index *index = parent->point_index;
+    unsigned int cell;
+
+    if (list_empty( &parent->children )) return NULL;
+
+    if (!index)
+    {
+        if (!(index = calloc( 1, sizeof(*index) ))) return NULL;
+        index->clip_gen = parent->clip_gen;
+        parent->point_index = index;
+    }
+    if (index->clip_gen != parent->clip_gen)
+    {
+        index->clip_gen = parent->clip_gen;
+        index->lookups = 0;
+        index->valid = 0;
+    }
+    if (!index->valid)
+    {
+        /* only build the index if the children don't change between hit tests */
+        if (index->lookups == ~0u || ++index->lookups < POINT_INDEX_MIN_LOOKUPS) return NULL;
+        if (!(index->valid = build_point_index( parent, index )))
+        {
+            index->lookups = ~0u;  /* don't try again until something changes */
+            return NULL;
+        }
+    }
+
+    *count = 0;
+    if (x < index->bounds.left || x >= index->bounds.right ||
+        y < index->bounds.top || y >= index->bounds.bottom)
+        return index->windows;
+
+    cell = (y - index->bounds.top) / index->cell_height * POINT_INDEX_GRID +
+           (x - index->bounds.left) / index->cell_width;
+    *count = index->cells[cell + 1] - index->cells[cell];
+    return index->windows + index->cells[cell];
+}
+
+/* free the spatial index of a window */
+static void free_point_index( struct window *win )
+{
+    if (!win->point_index) return;
+    free( win->point_index->cells );
+    free( win->point_index->windows );
+    free( win->point_index );
+    win->point_index = NULL;
+}
+
+/* iterator over the children containing a point */
+struct point_iterator
+{
+    struct window   *parent;
+    struct window   *ptr;
+    struct window  **windows;
+    unsigned int     count;
+    int              x;
+    int              y;
+};
+
+/* get the next child (in Z-order) that contains the point */
+static struct window *next_child_at_point( struct point_iterator *iter )
+{
+    if (iter->windows)
+    {
+        while (iter->count)
+        {
+            iter->count--;
+            iter->ptr = *iter->windows++;
+            if (is_point_in_window( iter->ptr, iter->x, iter->y )) return iter->ptr;
+        }
+        return NULL;
+    }
+    while ((iter->ptr = iter->ptr ? get_next_window( iter->ptr ) : get_first_child( iter->parent )))
+        if (is_point_in_window( iter->ptr, iter->x, iter->y )) return iter->ptr;
+    return NULL;
+}
+
+/* get the first child (in Z-order) that contains the point (in parent-relative coords) */
+static struct window *first_child_at_point( struct window *parent, int x, int y,
+                                            struct point_iterator *iter )
+{
+    iter->parent  = parent;
+    iter->ptr     = NULL;
+    iter->x       = x;
+    iter->y       = y;
+    iter->windows = get_children_at_point( parent, x, y, &iter->count );
+    return next_child_at_point( iter );
+}
 
+/* find child of 'parent' that contains the given point (in parent-relative coords) */
+static struct window *child_window_from_point( struct window *parent, int x, int y )
+{
+    struct point_iterator iter;
+    struct window *ptr;
+
+    if ((ptr = first_child_at_point( parent, x, y, &iter )))
+    {
         /* if window is minimized or disabled, return at once */
         if (ptr->style & (WS_MINIMIZE|WS_DISABLED)) return ptr;
 
@@ -710,12 +931,11 @@ static struct window *child_window_from_point( struct window *parent, int x, int
 static int get_window_children_from_point( struct window *parent, int x, int y,
                                            struct user_handle_array *array )
 {
+    struct point_iterator iter;
     struct window *ptr;
 
-    LIST_FOR_EACH_ENTRY( ptr, &parent->children, struct window, entry )
+    for (ptr = first_child_at_point( parent, x, y, &iter ); ptr; ptr = next_child_at_point( &iter ))
     {
-        if (!is_point_in_window( ptr, x, y )) continue;  /* skip it */
-
         /* if point is in client area, and window is not minimized or disabled, check children */
         if (!(ptr->style & (WS_MINIMIZE|WS_DISABLED)) &&
             x >= ptr->client_rect.left && x < ptr->client_rect.right &&
@@ -735,15 +955,12 @@ static int get_window_children_from_point( struct window *parent, int x, int y,
 /* get handle of root of top-most window containing point */
 user_handle_t shallow_window_from_point( struct desktop *desktop, int x, int y )
 {
+    struct point_iterator iter;
     struct window *ptr;
 
     if (!desktop->top_window) return 0;
 
-    LIST_FOR_EACH_ENTRY( ptr, &desktop->top_window->children, struct window, entry )
-    {
-        if (!is_point_in_window( ptr, x, y )) continue;  /* skip it */
-        return ptr->handle;
-    }
+    if ((ptr = first_child_at_point( desktop->top_window, x, y, &iter ))) return ptr->handle;
     return desktop->top_window->handle;
 }
 
@@ -973,7 +1190,7 @@ static inline struct window *get_top_clipping_window( struct window *win )
 
 
 /* compute the visible region of a window, in window coordinates */
-static struct region *get_visible_region( struct window *win, unsigned int flags )
+static struct region *compute_visible_region( struct window *win, unsigned int flags )
 {
     struct region *tmp = NULL, *region;
     int offset_x, offset_y;
@@ -1059,6 +1276,45 @@ error:
 }
 
 
+/* get the visible region of a window, in window coordinates, reusing the cached one if still valid */
+static struct region *get_visible_region( struct window *win, unsigned int flags )
+{
+    struct region *region;
+    struct window *ptr;
+    unsigned int gen = 0;
+
+    flags &= DCX_PARENTCLIP | DCX_WINDOW | DCX_CLIPCHILDREN;
+
+    /* the region depends on the window, its ancestors and their children */
+    for (ptr = win; ptr; ptr = ptr->parent) gen = max( gen, ptr->clip_gen );
+
+    if (win->vis_cache && win->vis_cache_flags == flags && win->vis_cache_gen == gen)
+    {
+        if (!(region = create_empty_region())) return NULL;
+        if (copy_region( region, win->vis_cache )) return region;
+        free_region( region );
+        return NULL;
+    }
+
+    if (!(region = compute_visible_region( win, flags ))) return NULL;
+
+    if (win->vis_cache || (win->vis_cache = create_empty_region()))
+    {
+        if (copy_region( win->vis_cache, region ))
+        {
+            win->vis_cache_flags = flags;
+            win->vis_cache_gen = gen;
+        }
+        else
+        {
+            free_region( win->vis_cache );
+            win->vis_cache = NULL;
+        }
+    }
+    return region;
+}
+
+
 /* clip all children with a custom pixel format out of the visible region */
 static struct region *clip_pixel_format_children( struct window *parent, struct region *parent_clip,
                                                   struct region *region, int offset_x, int offset_y )
@@ -1659,6 +1915,7 @@ static void set_window_pos( struct window *win, struct window *previous,
     win->window_rect  = *window_rect;
     win->visible_rect = *visible_rect;
     win->client_rect  = *client_rect;
+    invalidate_visible_regions( win );
     if (!(swp_flags & SWP_NOZORDER) && win->parent) link_window( win, previous );
     if (swp_flags & SWP_SHOWWINDOW) win->style |= WS_VISIBLE;
     else if (swp_flags & SWP_HIDEWINDOW) win->style &= ~WS_VISIBLE;
@@ -1817,6 +2074,7 @@ static void set_window_region( struct window *win, struct region *region, int re
 
     if (win->win_region) free_region( win->win_region );
     win->win_region = region;
+    invalidate_visible_regions( win );
 
     /* expose anything revealed by the change */
     if (old_vis_rgn && ((exposed_rgn = expose_window( win, &win->window_rect, old_vis_rgn ))))
@@ -1846,6 +2104,7 @@ void destroy_window( struct window *win )
     {
         struct region *vis_rgn = get_visible_region( win, DCX_WINDOW );
         win->style &= ~WS_VISIBLE;
+        invalidate_visible_regions( win );
         if (vis_rgn)
         {
             struct region *exposed_rgn = expose_window( win, &win->window_rect, vis_rgn );
@@ -1871,6 +2130,7 @@ void destroy_window( struct window *win )
     cleanup_clipboard_window( win->desktop, win->handle );
     free_user_handle( win->handle );
     destroy_properties( win );
+    invalidate_visible_regions( win );
     list_remove( &win->entry );
     if (is_desktop_window(win))
     {
@@ -1888,6 +2148,8 @@ void destroy_window( struct window *win )
     if (win->win_region) free_region( win->win_region );
     if (win->layer_region) free_region( win->layer_region );
     if (win->update_region) free_region( win->update_region );
+    if (win->vis_cache) free_region( win->vis_cache );
+    free_point_index( win );
     if (win->class) release_class( win->class );
     free( win->text );
     memset( win, 0x55, sizeof(*win) + win->nb_extra_bytes - 1 );
@@ -2028,6 +2290,7 @@ DECL_HANDLER(set_window_owner)
 
     reply->prev_owner = win->owner;
     reply->full_owner = win->owner = owner ? owner->handle : 0;
+    invalidate_window_info();
 }
 
 
@@ -2094,10 +2357,13 @@ DECL_HANDLER(set_window_info)
         else win->ex_style = (req->ex_style & ~WS_EX_TOPMOST) | (win->ex_style & WS_EX_TOPMOST);
         if (!(win->ex_style & WS_EX_LAYERED)) win->is_layered = 0;
     }
+    if (req->flags & (SET_WIN_STYLE | SET_WIN_EXSTYLE)) invalidate_visible_regions( win );
     if (req->flags & SET_WIN_ID) win->id = req->id;
     if (req->flags & SET_WIN_INSTANCE) win->instance = req->instance;
     if (req->flags & SET_WIN_UNICODE) win->is_unicode = req->is_unicode;
     if (req->flags & SET_WIN_USERDATA) win->user_data = req->user_data;
+    if (req->flags & (SET_WIN_STYLE | SET_WIN_EXSTYLE | SET_WIN_ID | SET_WIN_INSTANCE | SET_WIN_USERDATA))
+        invalidate_window_info();
     if (req->flags & SET_WIN_EXTRA) memcpy( win->extra_bytes + req->extra_offset,
                                             &req->extra_value, req->extra_size );
 
@@ -2673,6 +2939,7 @@ DECL_HANDLER(update_window_zorder)
         /* making sure to not violate the topmost rule */
         if (!(ptr->ex_style & WS_EX_TOPMOST) || (win->ex_style & WS_EX_TOPMOST))
         {
+            invalidate_visible_regions( win );
             list_remove( &win->entry );
             list_add_before( &ptr->entry, &win->entry );
         }